@@ -3,11 +3,20 @@
  * @author Rahul Kumar and Roger Xiao
  */
  
+#include <fstream>
 #include <iostream>
+#include <string>
 #include <stdlib.h>
 #include <time.h>
+#include "analysistree.h"
 #include "board.h"
+#include "deepening.h"
 #include "minimax.h"
+#include "multipv.h"
+#include "ponder.h"
+#include "poscache.h"
+#include "timing.h"
+#include "treedump.h"
 
 using namespace std;
 
@@ -24,17 +33,148 @@ using namespace std;
  * until the War Game ends. Finally, this function
  * displays the Blue and Green Players' scores.
  * 
- * @credit http://stackoverflow.com/questions/2808398/easily-measure-elapsed-time
- *         for time difference calculation.
+ * Optional flags:
+ * --ponder            AI Players search during their opponent's turn. An answer that was not
+ *                     pondered is searched from scratch, unless --cache is also given.
+ * --stats-json=FILE   write the statistics of each AI search to FILE, one JSON line per move.
+ * --stats-csv=FILE    write the statistics of each AI search to FILE, one CSV row per move.
+ * The statistics flags need a build with "make STATS=1".
+ * --games=N           play N War Games in a row with the same Board and Players.
+ * --trace=FILE        write the phases of each AI move to FILE in the Chrome trace format.
+ *                     Building the root of the tree is part of the search phase.
+ * --analysis=DEPTH    AI Players keep their whole tree, DEPTH deep, in an AnalysisTree.
+ * --bound-pruning     alpha-beta AI Players cut off nodes no score swing can save
+ *                     (ignored with --nnue or --quiescence).
+ * --lmr               alpha-beta AI Players search late, low-value para drops shallower first.
+ * --quiescence        alpha-beta AI Players keep searching Death Blitzes past their depth.
+ * --hints=K           show Human Players the K best moves, with their values and variations.
+ * --nnue=FILE         AI Players evaluate their leaves with the Network whose weights are in FILE.
+ * --tree-dump=FILE    stream the nodes of each AI search to FILE (see treeconv to read it).
+ * --tree-depth=D      only dump the nodes up to D plies deep.
+ * --tree-sample=N     only dump one in N of the subtrees two plies deep.
+ * --max-nodes=N       AI searches deepen one ply at a time until they have made N nodes,
+ *                     and play the move of the deepest search that finished.
+ * --max-memory=KB     AI searches deepen one ply at a time until a tree takes up KB kilobytes,
+ *                     and play the move of the deepest search that finished.
+ * --cache=FILE        alpha-beta AI Players keep the positions they search in FILE, and reuse
+ *                     the ones searched by earlier runs and by other processes using FILE.
+ * --cache-size=MB     size of the cache file, if it is created (64 MB by default).
+ * After the last War Game, the move latency percentiles over all War Games are displayed.
+ * 
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments, which hold the optional flags
  * @return 0 upon sucessful execution
  * 		   -1 upon failed execution
  */
-int main () 
+int main (int argc, char ** argv) 
 {
+	//read the optional flags.
+	bool enablePondering = false;
+	ofstream * statsJson = NULL;
+	ofstream * statsCsv = NULL;
+	int numGames = 1;
+	const char * traceFile = NULL;
+	int analysisDepth = 0;
+	bool enableBoundPruning = false;
+	bool enableLateMoveReductions = false;
+	bool enableQuiescence = false;
+	int numHints = 0;
+	const char * networkFile = NULL;
+	const char * treeFile = NULL;
+	int treeDepth = SearchStats::MAX_PLY;
+	int treeSample = 1;
+	long long maxNodes = 0;
+	long long maxBytes = 0;
+	const char * cacheFile = NULL;
+	long long cacheBytes = 64LL * 1024 * 1024;
+	for (int i = 1; i < argc; i++)
+	{
+		string flag = argv[i];
+		if (flag == "--ponder")
+			enablePondering = true;
+		else if (flag.compare(0, 13, "--stats-json=") == 0 && statsJson == NULL)
+			statsJson = new ofstream(flag.substr(13).c_str());
+		else if (flag.compare(0, 12, "--stats-csv=") == 0 && statsCsv == NULL)
+		{
+			statsCsv = new ofstream(flag.substr(12).c_str());
+			SearchStats::writeCsvHeader(*statsCsv);
+		}
+		else if (flag.compare(0, 8, "--games=") == 0 && atoi(flag.c_str() + 8) > 0)
+			numGames = atoi(flag.c_str() + 8);
+		else if (flag == "--bound-pruning")
+			enableBoundPruning = true;
+		else if (flag == "--lmr")
+			enableLateMoveReductions = true;
+		else if (flag == "--quiescence")
+			enableQuiescence = true;
+		else if (flag.compare(0, 11, "--analysis=") == 0 && atoi(flag.c_str() + 11) > 0)
+			analysisDepth = atoi(flag.c_str() + 11);
+		else if (flag.compare(0, 8, "--hints=") == 0 && atoi(flag.c_str() + 8) > 0)
+			numHints = atoi(flag.c_str() + 8);
+		else if (flag.compare(0, 7, "--nnue=") == 0)
+			networkFile = argv[i] + 7;
+		else if (flag.compare(0, 12, "--tree-dump=") == 0)
+			treeFile = argv[i] + 12;
+		else if (flag.compare(0, 13, "--tree-depth=") == 0 && atoi(flag.c_str() + 13) >= 0)
+			treeDepth = atoi(flag.c_str() + 13);
+		else if (flag.compare(0, 14, "--tree-sample=") == 0 && atoi(flag.c_str() + 14) > 0)
+			treeSample = atoi(flag.c_str() + 14);
+		else if (flag.compare(0, 12, "--max-nodes=") == 0 && atoll(flag.c_str() + 12) > 0)
+			maxNodes = atoll(flag.c_str() + 12);
+		else if (flag.compare(0, 13, "--max-memory=") == 0 && atoll(flag.c_str() + 13) > 0)
+			maxBytes = atoll(flag.c_str() + 13) * 1024;
+		else if (flag.compare(0, 8, "--cache=") == 0)
+			cacheFile = argv[i] + 8;
+		else if (flag.compare(0, 13, "--cache-size=") == 0 && atoll(flag.c_str() + 13) > 0)
+			cacheBytes = atoll(flag.c_str() + 13) * 1024 * 1024;
+		else if (flag.compare(0, 8, "--trace=") == 0)
+			traceFile = argv[i] + 8;
+		else
+		{
+			cout << "Unknown flag: " << flag << endl;
+			return -1;
+		}
+	}
+	//error handling for statistics that were not compiled in.
+	if ((statsJson != NULL || statsCsv != NULL) && SearchStats::ENABLED == false)
+	{
+		cout << "FLAG ERR: Rebuild with \"make clean; make STATS=1\" to write statistics" << endl;
+		return -1;
+	}
+	
+	//load the weights of the learned evaluation once, at startup.
+	Network network;
+	if (networkFile != NULL && network.load(networkFile) == false)
+	{
+		cout << "FILE ERR: " << networkFile << " is not a weight file of this Network" << endl;
+		return -1;
+	}
+	
+	//open the position cache, which all AI searches share.
+	PositionCache cache;
+	if (cacheFile != NULL && cache.open(cacheFile, cacheBytes) == false)
+	{
+		cout << "FILE ERR: " << cacheFile << " is not a cache file, or cannot be created" << endl;
+		return -1;
+	}
+	
+	//open the tree dump, which all AI searches stream to.
+	TreeDump * treeDump = NULL;
+	if (treeFile != NULL)
+	{
+		treeDump = new TreeDump(treeFile, treeDepth, treeSample);
+		if (treeDump->isOpen() == false)
+		{
+			cout << "FILE ERR: " << treeFile << " cannot be written" << endl;
+			return -1;
+		}
+	}
+	
 	//seed the RNG used in Minimax's chooseNextMove function.
 	srand (time(NULL)); 
 	
 	int input;
+	int boardNum;
 	Board * game;
 	
 	//LOAD THE BOARD============================================================
@@ -54,7 +194,8 @@ int main ()
 	//error handling for bad User input.
 	if (input > 0 && input < 6) 
 	{
-		game = new Board(input);
+		boardNum = input;
+		game = new Board(boardNum);
 	}
 	else 
 	{
@@ -121,162 +262,336 @@ int main ()
 		return -1;
 	}
 	
-	//FINAL SETUPS FOR MAIN GAME LOOP===========================================
+	//FINAL SETUPS FOR ALL WAR GAMES============================================
 	//==========================================================================
-	//total number of moves Player Blue and Green use in one War Game.
-	int numBlueMoves = 0;
-	int numGreenMoves = 0;
-	//total time Player Blue and Green take to make their moves in one War Game.
-	double totalTimeBlue = 0;
-	double totalTimeGreen = 0;
-	//total number of nodes Player Blue and Green traverse in their Minimax
-	//AIs (if applicable) in one War Game.
-	int totalNodesBlue = 0;
-	int totalNodesGreen = 0;
-	//set the first player to Player Blue.
-	char currPlayer = 'B';
-	//set the first player's AI attributes to Player Blue's attributes.
-	bool currPlayerUsesAB = playerBlueUsesAB;
-	bool currPlayerIsHuman = playerBlueIsHuman;
+	//search settings of Player Blue and Green's AIs.
+	Minimax::Options blueOptions(playerBlueUsesAB);
+	Minimax::Options greenOptions(playerGreenUsesAB);
+	blueOptions.enableBoundPruning = greenOptions.enableBoundPruning = enableBoundPruning;
+	blueOptions.enableLateMoveReductions = greenOptions.enableLateMoveReductions = enableLateMoveReductions;
+	blueOptions.enableQuiescence = greenOptions.enableQuiescence = enableQuiescence;
+	if (networkFile != NULL)
+		blueOptions.network = greenOptions.network = &network;
+	if (cacheFile != NULL)
+		blueOptions.cache = greenOptions.cache = &cache;
+	//latencies of every move and of every phase of an AI move, over all War Games.
+	LatencyRecorder latencyBlue("Move latency of Blue");
+	LatencyRecorder latencyGreen("Move latency of Green");
+	LatencyRecorder latencyPonderWait("Phase ponder wait");
+	LatencyRecorder latencySearch("Phase search");
+	LatencyRecorder latencySelect("Phase move selection");
+	LatencyRecorder latencyUpdate("Phase board update");
+	LatencyRecorder latencyTeardown("Phase teardown");
+	TraceWriter * trace = NULL;
+	if (traceFile != NULL)
+		trace = new TraceWriter(traceFile);
+	//if pondering is enabled, each AI Player gets a Ponderer.
+	Ponderer * ponderBlue = NULL;
+	Ponderer * ponderGreen = NULL;
+	if (enablePondering && playerBlueIsHuman == false)
+		ponderBlue = new Ponderer('B', blueOptions);
+	if (enablePondering && playerGreenIsHuman == false)
+		ponderGreen = new Ponderer('G', greenOptions);
 	
-	//MAIN GAME LOOP============================================================
-	//==========================================================================
-	while (game->isGameOver() == false)
+	for (int gameNum = 1; gameNum <= numGames; gameNum++)
 	{
-		//newline done for aesthetic purposes.
-		cout << endl;
-		
-		//if the current player has an AI type.
-		if (currPlayerIsHuman == false)
+		//FINAL SETUPS FOR MAIN GAME LOOP===========================================
+		//==========================================================================
+		//every War Game after the first starts on a freshly loaded Board.
+		if (gameNum > 1)
 		{
-			//output that an AI Player is choosing a move.
-			if (currPlayer == 'B')
-				cout << "Choose a move, AI Player Blue" << endl;
-			else
-				cout << "Choose a move, AI Player Green" << endl;
-			
-			//have the AI Player choose a move on the Board
-			//by building and traversing a Minimax Tree, with Alpha-Beta Pruning
-			//if it's enabled.
-			//also, the time it takes for the AI Player to choose a move is saved.
-			clock_t begin = clock();
-			Minimax * tree = new Minimax(currPlayer, game, currPlayerUsesAB);
-			int row = 0; int col = 0;
-			tree->chooseNextMove(row,col);
-			game->putPiece(row, col, currPlayer);
-			clock_t end = clock();
-			
-			//output that an AI Player made a move by taking
-			//a piece in position (row,column) on the Board.
-			cout << "Row: " << row << ", col: " << col << endl;
-		
-			//output the Board's state after an AI Player made a move.
+			delete game;
+			game = new Board(boardNum);
+			cout << endl;
+			cout << "Starting War Game " << gameNum << " of " << numGames << endl;
+		}
+		//total number of moves Player Blue and Green use in one War Game.
+		int numBlueMoves = 0;
+		int numGreenMoves = 0;
+		//total time Player Blue and Green take to make their moves in one War Game.
+		double totalTimeBlue = 0;
+		double totalTimeGreen = 0;
+		//total number of nodes Player Blue and Green traverse in their Minimax
+		//AIs (if applicable) in one War Game.
+		int totalNodesBlue = 0;
+		int totalNodesGreen = 0;
+		//set the first player to Player Blue.
+		char currPlayer = 'B';
+		//set the first player's AI attributes to Player Blue's attributes.
+		bool currPlayerUsesAB = playerBlueUsesAB;
+		bool currPlayerIsHuman = playerBlueIsHuman;
+		//the last move made, which an AI Player that ponders looks up.
+		int lastRow = -1;
+		int lastCol = -1;
+	
+		//MAIN GAME LOOP============================================================
+		//==========================================================================
+		while (game->isGameOver() == false)
+		{
+			//newline done for aesthetic purposes.
 			cout << endl;
-			game->printBoard();
-			//also, output Player Blue and Player Green's updated score.
-			game->updateScore(blueScore, greenScore);
-			cout << "Player Blue: " << blueScore 
-			     << ", Player Green: " << greenScore << endl;
 		
-			//update 3 attributes about the current player
-			//since they are an AI Player.
-			if (currPlayer == 'B')
-			{
-				totalTimeBlue += double(end - begin) / CLOCKS_PER_SEC;
-				totalNodesBlue += tree->getNumNodes();
-				numBlueMoves++;
-			}
-			else
+			//if the current player has an AI type.
+			if (currPlayerIsHuman == false)
 			{
-				totalTimeGreen += double(end - begin) / CLOCKS_PER_SEC;
-				totalNodesGreen += tree->getNumNodes();
-				numGreenMoves++;
-			}
-			//clean the Minimax Tree used to make a move.
-			delete tree;
-		}
-		else
-		{	
-			//output that a Human Player is choosing a move.
-			if (currPlayer == 'B')
-				cout << "Choose a move, Human Player Blue" << endl;
-			else
-				cout << "Choose a move, Human Player Green" << endl;
+				//output that an AI Player is choosing a move.
+				if (currPlayer == 'B')
+					cout << "Choose a move, AI Player Blue" << endl;
+				else
+					cout << "Choose a move, AI Player Green" << endl;
 			
-			//the time it takes for a Human Player to choose a move is saved.
-			clock_t begin = clock();
-			int row = 0; int col = 0;
+				//have the AI Player choose a move on the Board
+				//by building and traversing a Minimax Tree, with Alpha-Beta Pruning
+				//if it's enabled. If the AI Player pondered on the last move,
+				//its answer may already be known.
+				//also, the wall-clock time of each phase of the move is saved.
+				Stopwatch begin;
+				int row = 0; int col = 0; int numNodes = 0;
+				Ponderer * ponderer = (currPlayer == 'B') ? ponderBlue : ponderGreen;
+				bool pondered = (ponderer != NULL && lastRow >= 0 
+				                 && ponderer->finish(lastRow, lastCol, row, col, numNodes));
+				Minimax * tree = NULL;
+				DeepeningSearch * deepening = NULL;
+				AnalysisTree * analysis = NULL;
+				Stopwatch searchBegin;
+				if (pondered == false && analysisDepth > 0)
+					analysis = new AnalysisTree(currPlayer, game, currPlayerUsesAB, analysisDepth);
+				else if (pondered == false)
+				{
+					//only this search is dumped and held to the budgets, not the pondering.
+					Minimax::Options options = (currPlayer == 'B') ? blueOptions : greenOptions;
+					options.dump = treeDump;
+					options.maxNodes = maxNodes;
+					options.maxBytes = maxBytes;
+					if (maxNodes > 0 || maxBytes > 0)
+						deepening = new DeepeningSearch(currPlayer, game, options);
+					else
+						tree = new Minimax(currPlayer, game, options);
+				}
+				Stopwatch selectBegin;
+				if (tree != NULL)
+				{
+					tree->chooseNextMove(row,col);
+					numNodes = tree->getNumNodes();
+				}
+				else if (deepening != NULL)
+				{
+					deepening->chooseNextMove(row,col);
+					numNodes = deepening->getNumNodes();
+				}
+				else if (analysis != NULL)
+				{
+					analysis->chooseNextMove(row,col);
+					numNodes = analysis->getNumNodes();
+				}
+				Stopwatch updateBegin;
+				game->putPiece(row, col, currPlayer);
+				Stopwatch teardownBegin;
+				if (tree != NULL)
+				{
+					//write out the statistics of the search, if they are wanted.
+					int moveNumber = numBlueMoves + numGreenMoves + 1;
+					if (statsJson != NULL)
+						tree->getStats().writeJson(*statsJson, moveNumber, currPlayer);
+					if (statsCsv != NULL)
+						tree->getStats().writeCsv(*statsCsv, moveNumber, currPlayer);
+					//clean the Minimax Tree used to make a move.
+					delete tree;
+				}
+				if (deepening != NULL)
+				{
+					int moveNumber = numBlueMoves + numGreenMoves + 1;
+					if (statsJson != NULL)
+						deepening->getStats().writeJson(*statsJson, moveNumber, currPlayer);
+					if (statsCsv != NULL)
+						deepening->getStats().writeCsv(*statsCsv, moveNumber, currPlayer);
+				}
+				//an AnalysisTree is released all at once.
+				delete analysis;
+				Stopwatch end;
+				lastRow = row;
+				lastCol = col;
 			
-			//"Valid User Input" Loop where the loop is only broken out of
-			//when the User inputs a valid move for the Human Player to make.
-			while (true)
-			{
-				cout << "Row to move: ";
-				cin >> row;
-				cout << "Col to move: ";
-				cin >> col;
-				
-				//Player makes a valid move by taking
-				//a piece in position (row,column) on the Board.
-				if (game->putPiece(row, col, currPlayer) != 0)
+				//save the latency of each phase, and trace them if that is wanted.
+				//the search phase holds the whole constructor of the tree, so the
+				//wait before it is only the wait for the pondering to stop.
+				latencyPonderWait.record(searchBegin.secondsSince(begin));
+				latencySearch.record(selectBegin.secondsSince(searchBegin));
+				latencySelect.record(updateBegin.secondsSince(selectBegin));
+				latencyUpdate.record(teardownBegin.secondsSince(updateBegin));
+				latencyTeardown.record(end.secondsSince(teardownBegin));
+				if (trace != NULL)
 				{
-					break;
+					trace->span("move", gameNum, currPlayer, begin, end);
+					trace->span("ponder wait", gameNum, currPlayer, begin, searchBegin);
+					trace->span(pondered ? "ponder hit" : "search", gameNum, currPlayer, searchBegin, selectBegin);
+					trace->span("move selection", gameNum, currPlayer, selectBegin, updateBegin);
+					trace->span("board update", gameNum, currPlayer, updateBegin, teardownBegin);
+					trace->span("teardown", gameNum, currPlayer, teardownBegin, end);
 				}
-				else //Player makes an invalid move.
+			
+				//output that an AI Player made a move by taking
+				//a piece in position (row,column) on the Board.
+				cout << "Row: " << row << ", col: " << col << endl;
+				//also, output how close the search came to its budgets.
+				if (deepening != NULL)
 				{
-					cout << "Illegal Move. Try Again" << endl;
+					const SearchStats & stats = deepening->getStats();
+					cout << "Depth " << deepening->getCompletedDepth() << ", "
+					     << stats.nodesUsed << " nodes";
+					if (maxNodes > 0)
+						cout << " (" << 100 * stats.nodesUsed / maxNodes << "% of budget)";
+					cout << ", " << stats.peakBytes << " bytes at most";
+					if (maxBytes > 0)
+						cout << " (" << 100 * stats.peakBytes / maxBytes << "% of budget)";
 					cout << endl;
+					delete deepening;
 				}
+		
+				//output the Board's state after an AI Player made a move.
+				cout << endl;
+				game->printBoard();
+				//also, output Player Blue and Player Green's updated score.
+				game->updateScore(blueScore, greenScore);
+				cout << "Player Blue: " << blueScore 
+				     << ", Player Green: " << greenScore << endl;
+		
+				//update 3 attributes about the current player
+				//since they are an AI Player.
+				double moveTime = end.secondsSince(begin);
+				if (currPlayer == 'B')
+				{
+					totalTimeBlue += moveTime;
+					totalNodesBlue += numNodes;
+					numBlueMoves++;
+					latencyBlue.record(moveTime);
+				}
+				else
+				{
+					totalTimeGreen += moveTime;
+					totalNodesGreen += numNodes;
+					numGreenMoves++;
+					latencyGreen.record(moveTime);
+				}
+				//the AI Player ponders during its opponent's turn.
+				if (ponderer != NULL && game->isGameOver() == false)
+					ponderer->start(game);
 			}
-			clock_t end = clock();
+			else
+			{	
+				//output that a Human Player is choosing a move.
+				if (currPlayer == 'B')
+					cout << "Choose a move, Human Player Blue" << endl;
+				else
+					cout << "Choose a move, Human Player Green" << endl;
+				//show the best moves, if hints are wanted.
+				if (numHints > 0)
+				{
+					MultiPV hints(currPlayer, game, numHints, Minimax::DEPTH_OF_MINIMAX);
+					cout << "Hints:" << endl;
+					hints.printLines(cout);
+				}
 			
-			//output the Board's state after a Human Player made a move.
-			cout << endl;
-			game->printBoard();
-			//also, output Player Blue and Player Green's updated score.
-			game->updateScore(blueScore, greenScore);
-			cout << "Player Blue: " << blueScore 
-			     << ", Player Green: " << greenScore << endl;
+				//the time it takes for a Human Player to choose a move is saved.
+				Stopwatch begin;
+				int row = 0; int col = 0;
 			
-			//update 1 attribute about the current player
-			//since they are an AI Player.
-			if (currPlayer == 'B')
-			{
-				totalTimeBlue += double(end - begin) / CLOCKS_PER_SEC;
-				numBlueMoves++;
-			}
-			else
-			{
-				totalTimeGreen += double(end - begin) / CLOCKS_PER_SEC;
-				numGreenMoves++;
+				//"Valid User Input" Loop where the loop is only broken out of
+				//when the User inputs a valid move for the Human Player to make.
+				while (true)
+				{
+					cout << "Row to move: ";
+					cin >> row;
+					cout << "Col to move: ";
+					cin >> col;
+				
+					//Player makes a valid move by taking
+					//a piece in position (row,column) on the Board.
+					if (game->putPiece(row, col, currPlayer) != 0)
+					{
+						lastRow = row;
+						lastCol = col;
+						break;
+					}
+					else //Player makes an invalid move.
+					{
+						cout << "Illegal Move. Try Again" << endl;
+						cout << endl;
+					}
+				}
+				Stopwatch end;
+			
+				//output the Board's state after a Human Player made a move.
+				cout << endl;
+				game->printBoard();
+				//also, output Player Blue and Player Green's updated score.
+				game->updateScore(blueScore, greenScore);
+				cout << "Player Blue: " << blueScore 
+				     << ", Player Green: " << greenScore << endl;
+			
+				//update 1 attribute about the current player
+				//since they are an AI Player.
+				if (currPlayer == 'B')
+				{
+					totalTimeBlue += end.secondsSince(begin);
+					numBlueMoves++;
+				}
+				else
+				{
+					totalTimeGreen += end.secondsSince(begin);
+					numGreenMoves++;
+				}
 			}
-		}
 		
-		//change the current player to the other player.
-		currPlayerUsesAB = (currPlayer == 'B') ? playerGreenUsesAB : playerBlueUsesAB;
-		currPlayerIsHuman = (currPlayer == 'B') ? playerGreenIsHuman : playerBlueIsHuman;
-		currPlayer = (currPlayer == 'B') ? 'G' : 'B';
+			//change the current player to the other player.
+			currPlayerUsesAB = (currPlayer == 'B') ? playerGreenUsesAB : playerBlueUsesAB;
+			currPlayerIsHuman = (currPlayer == 'B') ? playerGreenIsHuman : playerBlueIsHuman;
+			currPlayer = (currPlayer == 'B') ? 'G' : 'B';
+		}
+	
+		//END OF MAIN GAME==========================================================
+		//==========================================================================
+		cout << "Game Over" << endl;
+		//output the victor based on which player got the highest score.
+		if (blueScore > greenScore) 
+			cout << "Player Blue wins by " << blueScore - greenScore << " points." << endl;
+		else if (blueScore < greenScore) 
+			cout << "Player Green wins by " << greenScore - blueScore << " points." << endl;
+		else 
+			cout << "Tie Game." << endl;
+		cout << endl;
+		//output attributes about Player Green and Blue's gameplay.
+		cout << "Total number of nodes expanded by Blue: " << totalNodesBlue 
+		     << ", total number of nodes expanded by Green: " << totalNodesGreen << endl;
+		cout << "Average number of nodes expanded by Blue: " << double(totalNodesBlue)/numBlueMoves
+			 << ", average number of nodes expanded by Green: " << double(totalNodesGreen)/numGreenMoves << endl;
+		cout << "Average time to make a move by Blue: " << double(totalTimeBlue)/numBlueMoves
+			 << ", average time to make a move by Green: " << double(totalTimeGreen)/numGreenMoves << endl;
 	}
+	//output how often pondering found the answer before it was needed.
+	if (ponderBlue != NULL)
+		cout << "Ponder hits by Blue: " << ponderBlue->getNumHits() 
+		     << " out of " << ponderBlue->getNumTries() << endl;
+	if (ponderGreen != NULL)
+		cout << "Ponder hits by Green: " << ponderGreen->getNumHits() 
+		     << " out of " << ponderGreen->getNumTries() << endl;
 	
-	//END OF MAIN GAME==========================================================
-	//==========================================================================
-	cout << "Game Over" << endl;
-	//output the victor based on which player got the highest score.
-	if (blueScore > greenScore) 
-		cout << "Player Blue wins by " << blueScore - greenScore << " points." << endl;
-	else if (blueScore < greenScore) 
-		cout << "Player Green wins by " << greenScore - blueScore << " points." << endl;
-	else 
-		cout << "Tie Game." << endl;
+	//output the tail latencies over all War Games.
 	cout << endl;
-	//output attributes about Player Green and Blue's gameplay.
-	cout << "Total number of nodes expanded by Blue: " << totalNodesBlue 
-	     << ", total number of nodes expanded by Green: " << totalNodesGreen << endl;
-	cout << "Average number of nodes expanded by Blue: " << double(totalNodesBlue)/numBlueMoves
-		 << ", average number of nodes expanded by Green: " << double(totalNodesGreen)/numGreenMoves << endl;
-	cout << "Average time to make a move by Blue: " << double(totalTimeBlue)/numBlueMoves
-		 << ", average time to make a move by Green: " << double(totalTimeGreen)/numGreenMoves << endl;
+	latencyBlue.print(cout);
+	latencyGreen.print(cout);
+	latencyPonderWait.print(cout);
+	latencySearch.print(cout);
+	latencySelect.print(cout);
+	latencyUpdate.print(cout);
+	latencyTeardown.print(cout);
 	
+	delete trace;
+	delete ponderBlue;
+	delete ponderGreen;
+	delete statsJson;
+	delete statsCsv;
+	delete treeDump;
 	delete game;
 	return 0;
 }
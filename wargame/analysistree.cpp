@@ -0,0 +1,279 @@
+/**
+ * @file analysistree.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "analysistree.h"
+#include <algorithm>
+#include "minimax.h"
+#include "stdlib.h"
+
+using namespace std;
+
+/**
+ * Constructor that builds an analysis tree for a 6x6 Board.
+ * 
+ * @param currPlayer Char which will be used to judge whether the root will be a min node or a max node.
+ * @param currBoard Board to use as the root of the tree
+ * @param enableAlphaBeta bool to judge if the tree is built with alpha-beta pruning
+ * @param depth Depth of the tree
+ */
+AnalysisTree::AnalysisTree(char currPlayer, const Board * currBoard, bool enableAlphaBeta, int depth)
+	: layout(currBoard)
+{
+	this->enableAlphaBeta = enableAlphaBeta;
+	this->maxDepth = depth;
+	this->numUsed = 0;
+	this->numNodes = 0;
+	this->build(currPlayer, Position(currBoard));
+}
+
+/**
+ * Constructor that builds an analysis tree for any Layout.
+ * 
+ * @param currPlayer Char which will be used to judge whether the root will be a min node or a max node.
+ * @param layout Layout of the board
+ * @param position Position to use as the root of the tree
+ * @param enableAlphaBeta bool to judge if the tree is built with alpha-beta pruning
+ * @param depth Depth of the tree
+ */
+AnalysisTree::AnalysisTree(char currPlayer, const Layout & layout, const Position & position,
+                           bool enableAlphaBeta, int depth)
+	: layout(layout)
+{
+	this->enableAlphaBeta = enableAlphaBeta;
+	this->maxDepth = depth;
+	this->numUsed = 0;
+	this->numNodes = 0;
+	this->build(currPlayer, position);
+}
+
+/**
+ * Frees the arena, one chunk at a time.
+ */
+AnalysisTree::~AnalysisTree()
+{
+	for (unsigned int i = 0; i < chunks.size(); i++)
+		delete [] chunks[i];
+}
+
+/**
+ * Getter function
+ * 
+ * @return layout Layout of the board
+ */
+const Layout & AnalysisTree::getLayout()
+{
+	return this->layout;
+}
+
+/**
+ * Getter function
+ * 
+ * @return Node The root of the tree, which is always at index 0
+ */
+const AnalysisTree::Node & AnalysisTree::getRoot()
+{
+	return this->at(0);
+}
+
+/**
+ * Getter function
+ * 
+ * @param index Index of a node, such as a node's firstChild
+ * 
+ * @return Node The node at index
+ */
+const AnalysisTree::Node & AnalysisTree::getNode(unsigned int index)
+{
+	return this->at(index);
+}
+
+/**
+ * Getter function
+ * 
+ * @return numNodes Number of nodes that were searched, counting the root
+ */
+unsigned int AnalysisTree::getNumNodes()
+{
+	return this->numNodes;
+}
+
+/**
+ * Finds how much memory the arena holds.
+ * 
+ * @return unsigned long long Bytes
+ */
+unsigned long long AnalysisTree::getBytesUsed()
+{
+	return (unsigned long long)chunks.size() * CHUNK_SIZE * sizeof(Node);
+}
+
+/**
+ * Function that stores the coordinate to make a move on
+ * the board to the params, just like Minimax::chooseNextMove.
+ * 
+ * @param row Int that will hold the row of the move to make.
+ * @param col Int that will hold the col of the move to make.
+ */
+void AnalysisTree::chooseNextMove(int & row, int & col)
+{
+	const Node & root = this->at(0);
+	//find the children whose values are equal to the root's value.
+	vector<unsigned int> listOfBestMoveIndices;
+	for (unsigned int i = 0; i < root.numChildren; i++)
+	{
+		if (this->at(root.firstChild + i).value == root.value)
+			listOfBestMoveIndices.push_back(root.firstChild + i);
+	}
+	//randomly pick one of these children.
+	int randIndex = rand() % ((int)listOfBestMoveIndices.size());
+	int cell = this->at(listOfBestMoveIndices.at(randIndex)).cell;
+	row = cell / layout.size;
+	col = cell % layout.size;
+}
+
+/**
+ * Releases every node at once. The chunks are kept, so that
+ * they can be reused without asking for memory again.
+ */
+void AnalysisTree::clear()
+{
+	this->numUsed = 0;
+	this->numNodes = 0;
+}
+
+/**
+ * Allocates nodes that sit next to each other in the arena.
+ * 
+ * @param count Number of nodes to allocate, at most CHUNK_SIZE
+ * 
+ * @return unsigned int Index of the first allocated node
+ */
+unsigned int AnalysisTree::allocate(unsigned int count)
+{
+	//nodes that sit next to each other must be in the same chunk.
+	if ((numUsed & (CHUNK_SIZE - 1)) + count > CHUNK_SIZE)
+		numUsed = (numUsed | (CHUNK_SIZE - 1)) + 1;
+	while (chunks.size() <= ((numUsed + count - 1) >> CHUNK_BITS))
+		chunks.push_back(new Node[CHUNK_SIZE]);
+	unsigned int first = numUsed;
+	numUsed += count;
+	return first;
+}
+
+/**
+ * Finds the node at an index of the arena.
+ * 
+ * @param index Index of the node
+ * 
+ * @return Node
+ */
+AnalysisTree::Node & AnalysisTree::at(unsigned int index)
+{
+	return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+}
+
+/**
+ * Helper function for the constructors which sets up
+ * the root and builds the rest of the tree.
+ * 
+ * @param currPlayer Player to move at the root
+ * @param position Position at the root
+ */
+void AnalysisTree::build(char currPlayer, const Position & position)
+{
+	unsigned int root = this->allocate(1);
+	Node & node = this->at(root);
+	node.position = position;
+	node.cell = 0;
+	node.firstChild = 0;
+	node.numChildren = 0;
+	node.value = 0;
+	numNodes++;
+	this->search(root, currPlayer, -1*Minimax::INFINITY, Minimax::INFINITY, 0);
+}
+
+/**
+ * Recursive helper function which builds the tree below a node,
+ * with the same values as Minimax::minimaxBuild, or Minimax::abMax
+ * and Minimax::abMin when alpha-beta pruning is enabled.
+ * 
+ * @param index Index of the node
+ * @param player Current player at a depth within the tree
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ * @param depth Int whose value is a base case
+ * 
+ * @return int Minimax value of node
+ */
+int AnalysisTree::search(unsigned int index, char player, int alpha, int beta, int depth)
+{
+	Node & node = this->at(index);
+	//BASE CASES================================================================
+	//if this node's game state is "Game Over".
+	if (node.position.isGameOver(layout))
+	{
+		int diff = node.position.scoreDiff(layout);
+		//utility function
+		if (diff > 0) node.value = 9001;
+		else if (diff == 0) node.value = 0;
+		else node.value = -9001;
+		return node.value;
+	}
+	//if this node is at the maximum depth of the tree.
+	if (depth == maxDepth)
+	{
+		node.value = node.position.scoreDiff(layout);
+		return node.value;
+	}
+
+	//RECURSIVE CASE============================================================
+	//the moves are searched in the same order as Minimax searches them: as
+	//generated, or best looking first under alpha-beta pruning.
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = node.position.generateMoves(layout, player, moves);
+	if (enableAlphaBeta)
+		Position::orderMoves(moves, numMoves);
+	//allocate all children next to each other, one for each move.
+	node.firstChild = this->allocate(numMoves);
+	node.numChildren = 0;
+	char nextPlayer = (player == Minimax::MAX) ? Minimax::MIN : Minimax::MAX;
+	int v = (player == Minimax::MAX) ? -1*Minimax::INFINITY : Minimax::INFINITY;
+
+	for (int i = 0; i < numMoves; i++)
+	{
+		Node & child = this->at(node.firstChild + node.numChildren);
+		child.position = node.position;
+		child.position.makeMove(moves[i], player);
+		child.cell = moves[i].cell;
+		child.firstChild = 0;
+		child.numChildren = 0;
+		child.value = 0;
+		node.numChildren++;
+		numNodes++;
+
+		int childValue = this->search(node.firstChild + node.numChildren - 1,
+		                              nextPlayer, alpha, beta, depth + 1);
+		if (player == Minimax::MAX)
+		{
+			v = max(v, childValue);
+			if (enableAlphaBeta && v >= beta)
+				break;
+			alpha = max(alpha, v);
+		}
+		else
+		{
+			v = min(v, childValue);
+			if (enableAlphaBeta && v <= alpha)
+				break;
+			beta = min(beta, v);
+		}
+	}
+	//after a cutoff, the children that were never searched give back their
+	//nodes, unless the searched children allocated nodes after them. Children
+	//at the maximum depth never do, and they are most of the tree.
+	if (numUsed == node.firstChild + numMoves)
+		numUsed = node.firstChild + node.numChildren;
+	node.value = v;
+	return node.value;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file analysistree.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef ANALYSISTREE_H
+#define ANALYSISTREE_H
+
+#include <vector>
+#include "board.h"
+#include "position.h"
+
+using namespace std;
+
+/**
+ * This class builds the same tree as Minimax with no options other than
+ * alpha-beta pruning, searching the children in the same order, but keeps
+ * all of it for analysis tools in a compact form. Nodes live in an arena,
+ * the children of a node sit next to each other and are found by
+ * index, and each node stores its board as a Position. The whole
+ * tree is released at once instead of node by node.
+ */
+class AnalysisTree
+{
+	public:
+		/**
+		 * This class is a node of an analysis tree. Its children are the
+		 * numChildren nodes starting at index firstChild. Under alpha-beta
+		 * pruning, only the children that were searched are kept.
+		 */
+		class Node
+		{
+			public:
+				int value;
+				Position position;
+				unsigned int firstChild;
+				unsigned char numChildren;
+				//cell of the move that led to this node.
+				unsigned char cell;
+		};
+
+		AnalysisTree(char currPlayer, const Board * currBoard, bool enableAlphaBeta, int depth);
+		AnalysisTree(char currPlayer, const Layout & layout, const Position & position,
+		             bool enableAlphaBeta, int depth);
+		~AnalysisTree();
+
+		const Layout & getLayout();
+		const Node & getRoot();
+		const Node & getNode(unsigned int index);
+		unsigned int getNumNodes();
+		unsigned long long getBytesUsed();
+
+		void chooseNextMove(int & row, int & col);
+		void clear();
+
+	private:
+		static const int CHUNK_BITS = 16;
+		static const unsigned int CHUNK_SIZE = 1 << CHUNK_BITS;
+
+		Layout layout;
+		bool enableAlphaBeta;
+		int maxDepth;
+		//the arena is a list of chunks of nodes. Nodes are allocated by
+		//bumping numUsed, and never move once they are allocated.
+		vector<Node *> chunks;
+		unsigned int numUsed;
+		unsigned int numNodes;
+
+		unsigned int allocate(unsigned int count);
+		Node & at(unsigned int index);
+		void build(char currPlayer, const Position & position);
+		int search(unsigned int index, char player, int alpha, int beta, int depth);
+};
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file bench.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <iostream>
+#include <stdlib.h>
+#include "minimax.h"
+#include "selfplay.h"
+
+using namespace std;
+
+/**
+ * The main function of the bench tool, which compares alpha-beta search
+ * with and without the extra pruning settings on all five Boards:
+ * 
+ * ./bench [GAMES]
+ * 
+ * For each Board and setting, it displays the nodes expanded when the
+ * setting plays GAMES War Games against itself (compared to plain
+ * alpha-beta doing the same), and its strength as its average winning
+ * margin and win-draw-loss count over GAMES War Games as each color
+ * against plain alpha-beta. GAMES defaults to 4.
+ * 
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ */
+int main (int argc, char ** argv)
+{
+	int numGames = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : 4;
+	const char * boardNames[5] = { "Keren", "Narvik", "Sevastopol", "Smolensk", "Westerplatte" };
+
+	//the settings to compare, the first of which is the baseline.
+	const int NUM_SETTINGS = 3;
+	const char * settingNames[NUM_SETTINGS] = { "alpha-beta", "+bound", "+bound+lmr" };
+	Minimax::Options settings[NUM_SETTINGS] = { Minimax::Options(true), Minimax::Options(true),
+	                                            Minimax::Options(true) };
+	settings[1].enableBoundPruning = true;
+	settings[2].enableBoundPruning = true;
+	settings[2].enableLateMoveReductions = true;
+
+	for (int board = 1; board <= 5; board++)
+	{
+		cout << boardNames[board - 1] << endl;
+		long long baselineNodes = 0;
+		for (int s = 0; s < NUM_SETTINGS; s++)
+		{
+			//nodes expanded in self-play.
+			long long nodes = 0;
+			for (int game = 0; game < numGames; game++)
+			{
+				srand(game + 1);
+				SelfPlay::GameRecord record = SelfPlay::playGame(board, settings[s], settings[s]);
+				nodes += record.nodesBlue + record.nodesGreen;
+			}
+			if (s == 0)
+				baselineNodes = nodes;
+
+			//strength against the baseline, playing each color with the same seeds.
+			int wins = 0; int draws = 0; int losses = 0;
+			long long margin = 0;
+			for (int game = 0; game < 2 * numGames; game++)
+			{
+				bool playsBlue = (game % 2 == 0);
+				srand(game / 2 + 1);
+				SelfPlay::GameRecord record = playsBlue
+					? SelfPlay::playGame(board, settings[s], settings[0])
+					: SelfPlay::playGame(board, settings[0], settings[s]);
+				int diff = record.blueScore - record.greenScore;
+				if (playsBlue == false) diff = -diff;
+				margin += diff;
+				if (diff > 0) wins++;
+				else if (diff == 0) draws++;
+				else losses++;
+			}
+			cout << "  " << settingNames[s] << ": " << nodes << " nodes ("
+			     << 100.0 * nodes / baselineNodes << "% of alpha-beta), margin "
+			     << double(margin) / (2 * numGames) << " per game, +"
+			     << wins << " =" << draws << " -" << losses << endl;
+		}
+	}
+	return 0;
+}
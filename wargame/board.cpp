@@ -161,6 +161,45 @@ void Board::printBoard()
 	}
 }
 
+/**
+ * Getter function
+ * 
+ * @param row X position of the piece
+ * @param col Y position of the piece
+ * 
+ * @return int Value of the piece at (row,col)
+ */
+int Board::getValue(int row, int col) const
+{
+	return this->gameBoard[row][col].value;
+}
+
+/**
+ * Getter function
+ * 
+ * @param row X position of the piece
+ * @param col Y position of the piece
+ * 
+ * @return char Player in control of the piece at (row,col), 'N' if none
+ */
+char Board::getPlayer(int row, int col) const
+{
+	return this->gameBoard[row][col].playerInControl;
+}
+
+/**
+ * Setter function, which gives a piece to a player without any
+ * para drop or death blitz. Used to set up a Board in a given state.
+ * 
+ * @param row X position of the piece
+ * @param col Y position of the piece
+ * @param player Player to put in control of the piece, 'N' if none
+ */
+void Board::setPlayer(int row, int col, char player)
+{
+	this->gameBoard[row][col].playerInControl = player;
+}
+
 /**
  * Default Constructor 
  * A board piece for the War Game Board.
@@ -20,6 +20,9 @@ class Board
 		int putPiece(int row, int col, char player);
 		void updateScore(int & blueScore, int & greenScore);
 		void printBoard();
+		int getValue(int row, int col) const;
+		char getPlayer(int row, int col) const;
+		void setPlayer(int row, int col, char player);
 		
 	private:
 		/**
@@ -0,0 +1,104 @@
+/**
+ * @file deepening.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "deepening.h"
+
+using namespace std;
+
+/**
+ * Constructor that runs the iterative deepening search.
+ * The node budget of the settings is shared by all the searches,
+ * while the memory budget holds for each search on its own, since
+ * the tree of a search is freed before the next one starts.
+ *
+ * @param currPlayer Char of the player to move
+ * @param currBoard Board to search, whose game must not be over
+ * @param options Settings of the search, whose maxDepth is the deepest search
+ */
+DeepeningSearch::DeepeningSearch(char currPlayer, const Board * currBoard, const Minimax::Options & options)
+{
+	this->row = 0;
+	this->col = 0;
+	this->numNodes = 0;
+	this->completedDepth = 0;
+	for (int depth = 1; depth <= options.maxDepth; depth++)
+	{
+		Minimax::Options searchOptions = options;
+		searchOptions.maxDepth = depth;
+		//the first ply always finishes, so that there is a move to make.
+		if (depth == 1)
+		{
+			searchOptions.stop = NULL;
+			searchOptions.deadline = chrono::steady_clock::time_point::max();
+			searchOptions.maxNodes = 0;
+			searchOptions.maxBytes = 0;
+		}
+		else if (options.maxNodes > 0)
+		{
+			//the deeper searches only get the nodes that are left.
+			if (numNodes >= options.maxNodes)
+			{
+				stats.budgetHit = true;
+				break;
+			}
+			searchOptions.maxNodes = options.maxNodes - numNodes;
+		}
+		Minimax * tree = new Minimax(currPlayer, currBoard, searchOptions);
+		numNodes += tree->getNumNodes();
+		stats.add(tree->getStats());
+		if (tree->wasAborted())
+		{
+			delete tree;
+			break;
+		}
+		tree->chooseNextMove(row, col);
+		completedDepth = depth;
+		delete tree;
+	}
+	stats.nodeBudget = options.maxNodes;
+	stats.byteBudget = options.maxBytes;
+}
+
+/**
+ * Function that stores the coordinate of the move chosen by
+ * the deepest search that finished to the params.
+ *
+ * @param row Int that will hold the row of the move to make.
+ * @param col Int that will hold the col of the move to make.
+ */
+void DeepeningSearch::chooseNextMove(int & row, int & col)
+{
+	row = this->row;
+	col = this->col;
+}
+
+/**
+ * Getter function
+ *
+ * @return numNodes Number of nodes expanded over all the searches
+ */
+int DeepeningSearch::getNumNodes()
+{
+	return this->numNodes;
+}
+
+/**
+ * Getter function
+ *
+ * @return completedDepth Depth of the deepest search that finished
+ */
+int DeepeningSearch::getCompletedDepth()
+{
+	return this->completedDepth;
+}
+
+/**
+ * Getter function
+ *
+ * @return stats Statistics of all the searches put together
+ */
+const SearchStats & DeepeningSearch::getStats()
+{
+	return this->stats;
+}
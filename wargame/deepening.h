@@ -0,0 +1,36 @@
+/**
+ * @file deepening.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef DEEPENING_H
+#define DEEPENING_H
+
+#include "board.h"
+#include "minimax.h"
+
+/**
+ * This class searches with iterative deepening: it builds a Minimax tree
+ * one ply deep, then two, and so on up to the settings' maxDepth. If the
+ * search is stopped, runs past its deadline, or runs out of its node or
+ * memory budget, the move of the deepest search that finished is used. The first ply is always searched in full,
+ * so there is always a move to make.
+ */
+class DeepeningSearch
+{
+	public:
+		DeepeningSearch(char currPlayer, const Board * currBoard, const Minimax::Options & options);
+
+		void chooseNextMove(int & row, int & col);
+		int getNumNodes();
+		int getCompletedDepth();
+		const SearchStats & getStats();
+
+	private:
+		int row;
+		int col;
+		int numNodes;
+		int completedDepth;
+		SearchStats stats;
+};
+
+#endif
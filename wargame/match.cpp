@@ -0,0 +1,159 @@
+/**
+ * @file match.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "match.h"
+#include <thread>
+#include <vector>
+#include "timing.h"
+
+using namespace std;
+
+/**
+ * Constructor of a match that has not been played yet.
+ *
+ * @param engineA The engine that is tested
+ * @param engineB The engine it is compared to
+ * @param test The SPRT that the pairs are counted in
+ * @param firstSeed Seed of the first pair on each Board
+ */
+Match::Match(const Tournament::Engine & engineA, const Tournament::Engine & engineB,
+             SPRT & test, unsigned int firstSeed)
+	: engineA(engineA), engineB(engineB), test(test)
+{
+	this->firstSeed = firstSeed;
+	this->nextPair = 0;
+	this->maxPairs = 0;
+	this->decided = false;
+	this->wins = 0;
+	this->draws = 0;
+	this->losses = 0;
+	this->nodesA = 0;
+	this->nodesB = 0;
+	this->secondsA = 0;
+	this->secondsB = 0;
+	this->seconds = 0;
+	this->progress = NULL;
+}
+
+/**
+ * Plays pairs until the SPRT accepts a hypothesis or maxPairs were played.
+ *
+ * @param numThreads Number of threads that play pairs at once
+ * @param maxPairs Most pairs to play
+ * @param progress Stream that the standing is written to as the match goes
+ */
+void Match::run(int numThreads, int maxPairs, ostream & progress)
+{
+	this->maxPairs = maxPairs;
+	this->progress = &progress;
+	Stopwatch begin;
+	vector<thread> threads;
+	for (int i = 0; i < numThreads; i++)
+		threads.push_back(thread(&Match::work, this));
+	for (unsigned int i = 0; i < threads.size(); i++)
+		threads[i].join();
+	Stopwatch end;
+	this->seconds = end.secondsSince(begin);
+}
+
+/**
+ * Writes the standing: the War Games, the pairs, the Elo difference,
+ * the SPRT's verdict, and the work each engine did.
+ *
+ * @param out Stream to write to
+ */
+void Match::printSummary(ostream & out)
+{
+	this->printStatus(out);
+	int numPairs = test.getNumPairs();
+	out << "Pairs by half-points of " << engineA.name << ": ";
+	for (int i = 0; i <= 4; i++)
+		out << (i > 0 ? " " : "") << i << ":" << test.getPairCount(i);
+	out << endl;
+	switch (test.getDecision())
+	{
+		case SPRT::ACCEPT_ELO1: out << "SPRT: " << engineA.name << " is stronger (H1 accepted)" << endl; break;
+		case SPRT::ACCEPT_ELO0: out << "SPRT: " << engineA.name << " is not stronger (H0 accepted)" << endl; break;
+		default: out << "SPRT: no decision after " << numPairs << " pairs" << endl; break;
+	}
+	int numGames = 2 * numPairs;
+	if (numGames > 0)
+	{
+		out << engineA.name << ": " << (double)nodesA / numGames << " nodes and "
+		    << secondsA / numGames << " seconds per War Game" << endl;
+		out << engineB.name << ": " << (double)nodesB / numGames << " nodes and "
+		    << secondsB / numGames << " seconds per War Game" << endl;
+	}
+	out << "Played " << numGames << " War Games in " << seconds << " seconds" << endl;
+}
+
+/**
+ * Body of each thread: takes the next pair, plays both of its War Games,
+ * and counts it, until the match is over.
+ */
+void Match::work()
+{
+	while (true)
+	{
+		int pair = 0;
+		{
+			lock_guard<mutex> guard(lock);
+			if (decided || nextPair >= maxPairs)
+				return;
+			pair = nextPair++;
+		}
+		int boardNum = pair % 5 + 1;
+		unsigned int seed = firstSeed + pair / 5;
+		SelfPlay::GameRecord blueA = SelfPlay::playGame(boardNum, engineA.options, engineB.options, seed);
+		SelfPlay::GameRecord greenA = SelfPlay::playGame(boardNum, engineB.options, engineA.options, seed);
+		this->addPair(blueA, greenA);
+	}
+}
+
+/**
+ * Counts a pair that was played, and checks if the SPRT has decided.
+ *
+ * @param blueA Record of the War Game where A played Blue
+ * @param greenA Record of the War Game where A played Green
+ */
+void Match::addPair(const SelfPlay::GameRecord & blueA, const SelfPlay::GameRecord & greenA)
+{
+	lock_guard<mutex> guard(lock);
+	//pairs that finish after the decision are left out, so that the
+	//standing is the one the SPRT decided on.
+	if (decided)
+		return;
+	int halfPoints = 0;
+	int margins[2] = { blueA.blueScore - blueA.greenScore, greenA.greenScore - greenA.blueScore };
+	for (int i = 0; i < 2; i++)
+	{
+		if (margins[i] > 0) { wins++; halfPoints += 2; }
+		else if (margins[i] == 0) { draws++; halfPoints += 1; }
+		else losses++;
+	}
+	nodesA += blueA.nodesBlue + greenA.nodesGreen;
+	nodesB += blueA.nodesGreen + greenA.nodesBlue;
+	secondsA += blueA.secondsBlue + greenA.secondsGreen;
+	secondsB += blueA.secondsGreen + greenA.secondsBlue;
+	test.addPair(halfPoints);
+	decided = (test.getDecision() != SPRT::CONTINUE);
+	if (test.getNumPairs() % PROGRESS_EVERY == 0)
+		this->printStatus(*progress);
+}
+
+/**
+ * Writes one line of the standing.
+ *
+ * @param out Stream to write to
+ */
+void Match::printStatus(ostream & out)
+{
+	double lower = 0; double upper = 0;
+	test.getEloInterval(lower, upper);
+	out << engineA.name << " vs " << engineB.name << ": " << 2 * test.getNumPairs()
+	    << " War Games, +" << wins << " =" << draws << " -" << losses
+	    << ", Elo " << test.getElo() << " [" << lower << ", " << upper << "]"
+	    << ", LLR " << test.getLlr() << " [" << test.getLowerBound() << ", "
+	    << test.getUpperBound() << "]" << endl;
+}
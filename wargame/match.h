@@ -0,0 +1,66 @@
+/**
+ * @file match.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef MATCH_H
+#define MATCH_H
+
+#include <mutex>
+#include <ostream>
+#include "selfplay.h"
+#include "sprt.h"
+#include "tournament.h"
+
+using namespace std;
+
+/**
+ * This class plays a match between two engines, A and B, and tells if
+ * A is stronger with an SPRT. The match is played in pairs of War Games:
+ * both War Games of a pair are on the same Board with the same seed,
+ * and A plays Blue in the first and Green in the second. Pair i is
+ * played on Board i % 5 + 1 with seed firstSeed + i / 5, so a pair is
+ * the same War Games whichever thread plays it.
+ *
+ * Pairs are played on several threads at once. After each pair the SPRT
+ * is updated, and once it accepts a hypothesis no new pairs are started
+ * and the pairs still being played are not counted.
+ */
+class Match
+{
+	public:
+		Match(const Tournament::Engine & engineA, const Tournament::Engine & engineB,
+		      SPRT & test, unsigned int firstSeed);
+
+		void run(int numThreads, int maxPairs, ostream & progress);
+		void printSummary(ostream & out);
+
+	private:
+		//progress is written every this many pairs.
+		static const int PROGRESS_EVERY = 20;
+
+		Tournament::Engine engineA;
+		Tournament::Engine engineB;
+		SPRT & test;
+		unsigned int firstSeed;
+		//guards everything below, which the threads share.
+		mutex lock;
+		int nextPair;
+		int maxPairs;
+		bool decided;
+		//War Games A won, drew and lost.
+		int wins;
+		int draws;
+		int losses;
+		long long nodesA;
+		long long nodesB;
+		double secondsA;
+		double secondsB;
+		double seconds;
+		ostream * progress;
+
+		void work();
+		void addPair(const SelfPlay::GameRecord & blueA, const SelfPlay::GameRecord & greenA);
+		void printStatus(ostream & out);
+};
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file matchmain.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "match.h"
+
+using namespace std;
+
+/**
+ * The main function of the match tool, which tells if AI engine A is
+ * stronger than AI engine B:
+ *
+ * ./match [--threads=N] [--max-pairs=N] [--elo0=E] [--elo1=E] [--alpha=P] [--beta=P]
+ *         [--seed=S] ENGINE_A ENGINE_B
+ *
+ * The ENGINEs (see tournament.h) play pairs of War Games that only differ
+ * by color (see match.h) on N threads (one per core by default), starting
+ * from seed S (default 1). The SPRT weighs A being elo0 (default 0) Elo
+ * stronger against it being elo1 (default 20) Elo stronger, with error
+ * chances alpha and beta (default 0.05 each), and the match stops once it
+ * decides or after max-pairs (default 500) pairs. The standing is displayed
+ * as the match goes and at the end.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	int numThreads = max(1, (int)thread::hardware_concurrency());
+	int maxPairs = 500;
+	double elo0 = 0;
+	double elo1 = 20;
+	double alpha = 0.05;
+	double beta = 0.05;
+	unsigned int firstSeed = 1;
+	vector<string> specs;
+	for (int i = 1; i < argc; i++)
+	{
+		string flag = argv[i];
+		if (flag.compare(0, 10, "--threads=") == 0 && atoi(flag.c_str() + 10) > 0)
+			numThreads = atoi(flag.c_str() + 10);
+		else if (flag.compare(0, 12, "--max-pairs=") == 0 && atoi(flag.c_str() + 12) > 0)
+			maxPairs = atoi(flag.c_str() + 12);
+		else if (flag.compare(0, 7, "--elo0=") == 0)
+			elo0 = atof(flag.c_str() + 7);
+		else if (flag.compare(0, 7, "--elo1=") == 0)
+			elo1 = atof(flag.c_str() + 7);
+		else if (flag.compare(0, 8, "--alpha=") == 0 && atof(flag.c_str() + 8) > 0 && atof(flag.c_str() + 8) < 0.5)
+			alpha = atof(flag.c_str() + 8);
+		else if (flag.compare(0, 7, "--beta=") == 0 && atof(flag.c_str() + 7) > 0 && atof(flag.c_str() + 7) < 0.5)
+			beta = atof(flag.c_str() + 7);
+		else if (flag.compare(0, 7, "--seed=") == 0)
+			firstSeed = strtoul(flag.c_str() + 7, NULL, 10);
+		else if (flag.compare(0, 2, "--") == 0)
+		{
+			cout << "Unknown flag: " << flag << endl;
+			return -1;
+		}
+		else
+			specs.push_back(flag);
+	}
+	if (specs.size() != 2 || elo1 <= elo0)
+	{
+		cout << "Usage: ./match [--threads=N] [--max-pairs=N] [--elo0=E] [--elo1=E] [--alpha=P] [--beta=P]"
+		     << " [--seed=S] ENGINE_A ENGINE_B (with elo0 < elo1)" << endl;
+		return -1;
+	}
+
+	Tournament::Engine engines[2];
+	for (int i = 0; i < 2; i++)
+	{
+		if (Tournament::parseEngine(specs[i], engines[i]) == false)
+		{
+			cout << "ENGINE ERR: " << specs[i] << " is not a valid engine" << endl;
+			if (i == 1)
+			{
+				delete engines[0].network;
+				delete engines[0].cache;
+			}
+			return -1;
+		}
+	}
+	SPRT test(elo0, elo1, alpha, beta);
+	Match match(engines[0], engines[1], test, firstSeed);
+	match.run(numThreads, maxPairs, cout);
+	match.printSummary(cout);
+	for (int i = 0; i < 2; i++)
+	{
+		delete engines[i].network;
+		delete engines[i].cache;
+	}
+	return 0;
+}
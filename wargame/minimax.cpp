@@ -4,6 +4,7 @@
  */
 #include "minimax.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include "board.h"
 #include "stdlib.h"
@@ -18,10 +19,48 @@ using namespace std;
  * @param enableAlphaBeta bool to judge if the player uses alpha-beta search rather than minimax search
  */
 Minimax::Minimax(char currPlayer, const Board * currBoard, bool enableAlphaBeta)
+	: Minimax(currPlayer, currBoard, Options(enableAlphaBeta))
+{
+}
+
+/**
+ * Constructor that builds a minimax tree with the given search settings.
+ * 
+ * @param currPlayer Char which will be used to judge whether the root will be a min node or a max node.
+ * @param currBoard Board to use as the root of the minimax tree
+ * @param options Settings of the search, such as alpha-beta pruning and the stop flag
+ */
+Minimax::Minimax(char currPlayer, const Board * currBoard, const Options & options)
+	: options(options), layout(currBoard)
 {
 	this->numNodesExpanded = 0;
+	this->aborted = false;
+	this->numStopChecks = 0;
+	this->nextReduced = false;
+	this->bytesUsed = 0;
+	//a learned evaluation is no longer bounded by the score swings.
+	if (options.network != NULL)
+	{
+		this->options.enableBoundPruning = false;
+		accumulators.reserve(options.maxDepth + 2);
+		accumulators.push_back(Network::Accumulator());
+		options.network->refresh(Position(currBoard), accumulators.back());
+		this->account(accumulators.capacity() * sizeof(Network::Accumulator));
+		//the cached values and the blitz search only know the material count.
+		this->options.cache = NULL;
+		this->options.enableQuiescence = false;
+	}
+	//the score swings only bound the plies up to the maximum depth, but
+	//the blitz search goes on past it, and the game can end there.
+	if (this->options.enableQuiescence)
+		this->options.enableBoundPruning = false;
+	this->layoutKey = (this->options.cache != NULL) ? PositionCache::layoutKey(layout) : 0;
+	//values found with the blitz search are kept apart from the others.
+	if (this->options.enableQuiescence)
+		this->layoutKey = ~this->layoutKey;
+	STATS(chrono::steady_clock::time_point begin = chrono::steady_clock::now());
 	//if alpha-beta pruning is enabled.
-	if (enableAlphaBeta)
+	if (options.enableAlphaBeta)
 	{
 		//use a helper function to build a minimax tree with alpha-beta pruning.
 		alphaBetaBuild(currPlayer, currBoard);
@@ -33,9 +72,15 @@ Minimax::Minimax(char currPlayer, const Board * currBoard, bool enableAlphaBeta)
 		this->head = new Node(headBoard, 0, 0);
 		//account for this node's creation.
 		numNodesExpanded++;
+		this->account(this->nodeBytes(this->head));
 		//go to a helper function to build the rest of it.
 		minimaxBuild(this->head, currPlayer, 0);
 	}
+	STATS(stats.iterationTimes.push_back(
+		chrono::duration<double>(chrono::steady_clock::now() - begin).count()));
+	stats.nodesUsed = numNodesExpanded;
+	stats.nodeBudget = options.maxNodes;
+	stats.byteBudget = options.maxBytes;
 }
 
 /**
@@ -58,12 +103,9 @@ void Minimax::clear(Node * node)
 {
 	//if this node has children, then recursively
 	//free the children first.
-	while (node->children.empty() == false)
-	{
-		this->clear(node->children.back());
-		node->children.pop_back();
-	}
+	this->clearChildren(node);
 	//now free this node and its board member.
+	this->account(-1*this->nodeBytes(node));
 	delete node->board;
 	delete node;
 }
@@ -83,6 +125,32 @@ Minimax::Node::Node(Board * board, int rowMove, int colMove)
 	this->value = 0;
 }
 
+/**
+ * Constructor of the search settings.
+ * By default, the search is DEPTH_OF_MINIMAX deep, no extra pruning
+ * or quiescence search is done, nothing can stop the search early, there are no budgets,
+ * leaves are evaluated by the material count alone, the tree
+ * is not dumped, and ties are broken with rand().
+ * 
+ * @param enableAlphaBeta bool to judge if the search uses alpha-beta pruning
+ */
+Minimax::Options::Options(bool enableAlphaBeta)
+{
+	this->enableAlphaBeta = enableAlphaBeta;
+	this->enableBoundPruning = false;
+	this->enableLateMoveReductions = false;
+	this->maxDepth = DEPTH_OF_MINIMAX;
+	this->stop = NULL;
+	this->deadline = chrono::steady_clock::time_point::max();
+	this->network = NULL;
+	this->dump = NULL;
+	this->maxNodes = 0;
+	this->maxBytes = 0;
+	this->cache = NULL;
+	this->enableQuiescence = false;
+	this->randomState = NULL;
+}
+
 
 
 /**
@@ -97,6 +165,11 @@ Minimax::Node::Node(Board * board, int rowMove, int colMove)
  */
 int Minimax::minimaxBuild(Node * node, char player, int depth)
 {
+	//if another thread stopped the search, unwind without searching further.
+	if (this->stopRequested())
+		return node->value;
+	STATS(this->countNode(depth));
+	this->traceEnter(node, player, -1*INFINITY, INFINITY);
 	//BASE CASES================================================================
 	//Utility(node) if node is terminal=========================================
 	//if this node's game state is "Game Over".
@@ -104,45 +177,36 @@ int Minimax::minimaxBuild(Node * node, char player, int depth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
+		STATS(stats.terminalNodes++);
 		//utility function
 		if (blue > green) node->value = 9001;
 		else if (blue == green) node->value = 0;
 		else node->value = -9001;
-		return node->value;
+		return this->traceExit(node->value, TreeDump::TERMINAL);
 	}
 	//if this node is at the maximum depth of the minimax tree.
-	if (depth == DEPTH_OF_MINIMAX )
+	if (depth == options.maxDepth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
+		STATS(stats.leafEvals++);
 		//utility function
-		node->value = blue - green;
-		return node->value;
+		node->value = blue - green + this->correction(player);
+		return this->traceExit(node->value, TreeDump::LEAF);
 	}
 	//RECURSIVE CASE============================================================
 	//max_action Minimax(Succ(node, action)) if player = MAX====================
 	//min_action Minimax(Succ(node, action)) if player = MIN====================
-	//let player take a piece on all possible spots on the Board. 
-	for (int i = 0; i < 6; i++)
+	STATS(stats.interiorNodes++);
+	//let player take a piece on all possible spots on the Board,
+	//which are all found at once by the move generator.
+	Position position(node->board);
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	for (int i = 0; i < numMoves; i++)
 	{
-		for (int j = 0; j < 6; j++)
-		{
-			Board * childBoard = new Board(node->board);
-			
-			//For all legal moves, make the new Board States into this node's children.
-			int moveProp = childBoard->putPiece(i, j, player);
-			if (moveProp != 0)
-			{
-				Node * child = new Node(childBoard,i,j);
-				node->children.push_back(child);
-				//account for this node's creation.
-				this->numNodesExpanded++;
-			}
-			else
-			{
-				delete childBoard;
-			}
-		}
+		//For all legal moves, make the new Board States into this node's children.
+		node->children.push_back(this->makeChild(node, position, moves[i], player, depth));
 	}
 	//set up minimax variables and update the next player.
 	int maxVal = -1*INFINITY;
@@ -154,14 +218,24 @@ int Minimax::minimaxBuild(Node * node, char player, int depth)
 	for (unsigned int i = 0; i < node->children.size(); i++)
 	{
 		Node * child = node->children.at(i);
+		//leaf children were already evaluated by makeChild.
+		int childValue = child->value;
+		if (child->board != NULL)
+		{
+			this->pushMove(moves[i], player);
+			childValue = minimaxBuild(child, nextPlayer, depth + 1);
+			this->popMove();
+		}
+		else
+			this->traceLeaf(child, position, nextPlayer, -1*INFINITY, INFINITY);
 		if (player == MAX)
-			maxVal = max(maxVal, minimaxBuild(child, nextPlayer, depth + 1));
+			maxVal = max(maxVal, childValue);
 		else
-			minVal = min(minVal, minimaxBuild(child, nextPlayer, depth + 1));
+			minVal = min(minVal, childValue);
 	}
 	if (player == MAX) node->value = maxVal;
 	else node->value = minVal;
-	return node->value;
+	return this->traceExit(node->value, aborted ? TreeDump::STOPPED : TreeDump::COMPLETE);
 }
 
 /**
@@ -183,6 +257,7 @@ void Minimax::alphaBetaBuild(char currPlayer, const Board * currBoard)
 	//account for this node's creation.
 	numNodesExpanded++;
 	this->head = new Node(headBoard, 0, 0);
+	this->account(this->nodeBytes(this->head));
 	
 	//start building the rest of the minimax tree (with alpha-beta pruning).
 	if (currPlayer == MAX)
@@ -205,6 +280,11 @@ void Minimax::alphaBetaBuild(char currPlayer, const Board * currBoard)
  */
 int Minimax::abMax(Node * node, char player, int alpha, int beta, int depth)
 {
+	//if another thread stopped the search, unwind without searching further.
+	if (this->stopRequested())
+		return node->value;
+	STATS(this->countNode(depth));
+	this->traceEnter(node, player, alpha, beta);
 	//BASE CASE=================================================================
 	//if Terminal(node) return Utility(node)====================================
 	//if this node's game state is "Game Over".
@@ -212,73 +292,118 @@ int Minimax::abMax(Node * node, char player, int alpha, int beta, int depth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
+		STATS(stats.terminalNodes++);
 		//utility function.
 		if (blue > green) node->value = 9001;
 		else if (blue == green) node->value = 0;
 		else node->value = -9001;
-		return node->value;
+		return this->traceExit(node->value, TreeDump::TERMINAL);
 	}
 	//if this node is at the maximum depth of the minimax tree.
-	if (depth == DEPTH_OF_MINIMAX )
+	if (depth == options.maxDepth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
-		//utility function.
-		node->value = blue - green;
-		return node->value;
+		STATS(stats.leafEvals++);
+		//utility function, unless blitzes are searched past the maximum depth.
+		if (options.enableQuiescence)
+			node->value = this->quiesce(Position(node->board), player, alpha, beta, 0);
+		else
+			node->value = blue - green + this->correction(player);
+		return this->traceExit(node->value, TreeDump::LEAF);
 	}
 	
 	//RECURSIVE CASE============================================================
 	//The comments in the recursive case are based on pseudocode for============
 	//Minimax with Alpha-Beta Pruning.==========================================
+	STATS(stats.interiorNodes++);
 	//v = −infinity
 	int v = -1*INFINITY;
 	char nextPlayer = (player == MAX) ? MIN : MAX;
 	
-	//Set up each action in node
+	//a deep enough result of an earlier search settles the node,
+	//and otherwise its best move is searched first.
+	Position position(node->board);
+	int originalAlpha = alpha;
+	int originalBeta = beta;
+	int cachedCell = -1;
+	int bestCell = -1;
+	if (this->probeCache(position, player, alpha, beta, depth, node->value, cachedCell))
+		return this->traceExit(node->value, TreeDump::CACHED);
+	
+	//if even the largest possible score swing from here cannot
+	//reach the alpha-beta window, there is no need to search further.
+	int bound = 0;
+	if (options.enableBoundPruning && this->boundCutoff(position, player, alpha, beta, depth, bound))
+	{
+		STATS(stats.boundCutoffs++);
+		node->value = bound;
+		return this->traceExit(node->value, TreeDump::BOUND);
+	}
+	
+	//Set up each action in node, best looking actions first,
+	//without making any child Boards yet.
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	Position::orderMoves(moves, numMoves);
+	Minimax::moveToFront(moves, numMoves, cachedCell);
 	//AND for each action in node
-	for (int i = 0; i < 6; i++)
+	for (int i = 0; i < numMoves; i++)
 	{
-		for (int j = 0; j < 6; j++)
+		Node * child = this->makeChild(node, position, moves[i], player, depth);
+		node->children.push_back(child);
+		
+		// v = Max(v, Min-Value(Succ(node, action), alpha, beta)) 
+		//leaf children were already evaluated by makeChild.
+		int childValue = child->value;
+		if (child->board != NULL)
 		{
-			Board * childBoard = new Board(node->board);
-			
-			int moveProp = childBoard->putPiece(i, j, player);
-			if (moveProp != 0)
+			this->pushMove(moves[i], player);
+			if (this->canReduce(moves, numMoves, i, depth))
 			{
-				this->numNodesExpanded++;
-				Node * child = new Node(childBoard,i,j);
-				
-				// v = Max(v, Min-Value(Succ(node, action), alpha, beta)) 
-				v = max(v, abMin(child, nextPlayer, alpha, beta, depth+1));
-				
-				//Best Move pushed forward, worst move pushed backward
-				if (moveProp == 2 && node->children.empty() == false) 
-					node->children.insert(node->children.begin(), child);
-				else if (moveProp == 2 && node->children.empty() == true) 
-					node->children.push_back(child);
-				else 
-					node->children.push_back(child);
-				
-				//if v >= beta return v
-				if (v >= beta)
+				//search a late, low-value para drop one ply shallower first.
+				STATS(stats.reductions++);
+				this->nextReduced = true;
+				childValue = abMin(child, nextPlayer, alpha, beta, depth+2);
+				//if it still looks good enough, search it again at full depth.
+				if (childValue > alpha)
 				{
-					node->value = v;
-					return node->value;
+					STATS(stats.researches++);
+					this->clearChildren(child);
+					childValue = abMin(child, nextPlayer, alpha, beta, depth+1);
 				}
-				//alpha = Max(alpha, v) 
-				alpha = max(alpha, v);
 			}
 			else
-			{
-				delete childBoard;
-			}
+				childValue = abMin(child, nextPlayer, alpha, beta, depth+1);
+			this->popMove();
+		}
+		else
+		{
+			this->extendLeaf(child, position, moves[i], player, alpha, beta);
+			childValue = child->value;
+			this->traceLeaf(child, position, nextPlayer, alpha, beta);
+		}
+		if (childValue > v)
+			bestCell = moves[i].cell;
+		v = max(v, childValue);
+		
+		//if v >= beta return v
+		if (v >= beta)
+		{
+			STATS(stats.betaCutoffs++);
+			STATS(if (node->children.size() == 1) stats.firstMoveCutoffs++);
+			node->value = v;
+			this->storeCache(position, player, originalAlpha, originalBeta, depth, v, bestCell);
+			return this->traceExit(node->value, TreeDump::CUTOFF);
 		}
+		//alpha = Max(alpha, v) 
+		alpha = max(alpha, v);
 	}
 	//end for
 	//return v
 	node->value = v;
-	return node->value;
+	this->storeCache(position, player, originalAlpha, originalBeta, depth, v, bestCell);
+	return this->traceExit(node->value, aborted ? TreeDump::STOPPED : TreeDump::COMPLETE);
 }
 
 /**
@@ -295,6 +420,11 @@ int Minimax::abMax(Node * node, char player, int alpha, int beta, int depth)
  */
 int Minimax::abMin(Node * node, char player, int alpha, int beta, int depth)
 {
+	//if another thread stopped the search, unwind without searching further.
+	if (this->stopRequested())
+		return node->value;
+	STATS(this->countNode(depth));
+	this->traceEnter(node, player, alpha, beta);
 	//BASE CASE=================================================================
 	//if Terminal(node) return Utility(node)====================================
 	//if this node's game state is "Game Over".
@@ -302,72 +432,118 @@ int Minimax::abMin(Node * node, char player, int alpha, int beta, int depth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
+		STATS(stats.terminalNodes++);
 		//utility function
 		if (blue > green) node->value = 9001;
 		else if (blue == green) node->value = 0;
 		else node->value = -9001;
-		return node->value;
+		return this->traceExit(node->value, TreeDump::TERMINAL);
 	}
 	//if this node is at the maximum depth of the minimax tree.
-	if (depth == DEPTH_OF_MINIMAX )
+	if (depth == options.maxDepth)
 	{
 		int blue = 0; int green = 0;
 		node->board->updateScore(blue, green);
-		//utility function
-		node->value = blue - green;
-		return node->value;
+		STATS(stats.leafEvals++);
+		//utility function, unless blitzes are searched past the maximum depth
+		if (options.enableQuiescence)
+			node->value = this->quiesce(Position(node->board), player, alpha, beta, 0);
+		else
+			node->value = blue - green + this->correction(player);
+		return this->traceExit(node->value, TreeDump::LEAF);
 	}
 	
 	//RECURSIVE CASE============================================================
 	//The comments in the recursive case are based on pseudocode for============
 	//Minimax with Alpha-Beta Pruning.==========================================
+	STATS(stats.interiorNodes++);
 	//v = infinity
 	int v = INFINITY;
 	char nextPlayer = (player == MAX) ? MIN : MAX;
 	
-	//Set up each action in node
-	for (int i = 0; i < 6; i++)
+	//a deep enough result of an earlier search settles the node,
+	//and otherwise its best move is searched first.
+	Position position(node->board);
+	int originalAlpha = alpha;
+	int originalBeta = beta;
+	int cachedCell = -1;
+	int bestCell = -1;
+	if (this->probeCache(position, player, alpha, beta, depth, node->value, cachedCell))
+		return this->traceExit(node->value, TreeDump::CACHED);
+	
+	//if even the largest possible score swing from here cannot
+	//reach the alpha-beta window, there is no need to search further.
+	int bound = 0;
+	if (options.enableBoundPruning && this->boundCutoff(position, player, alpha, beta, depth, bound))
+	{
+		STATS(stats.boundCutoffs++);
+		node->value = bound;
+		return this->traceExit(node->value, TreeDump::BOUND);
+	}
+	
+	//Set up each action in node, best looking actions first,
+	//without making any child Boards yet.
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	Position::orderMoves(moves, numMoves);
+	Minimax::moveToFront(moves, numMoves, cachedCell);
+	//AND for each action in node
+	for (int i = 0; i < numMoves; i++)
 	{
-		for (int j = 0; j < 6; j++)
+		Node * child = this->makeChild(node, position, moves[i], player, depth);
+		node->children.push_back(child);
+		
+		// v = Min(v, Max-Value(Succ(node, action), alpha, beta)) 
+		//leaf children were already evaluated by makeChild.
+		int childValue = child->value;
+		if (child->board != NULL)
 		{
-			Board * childBoard = new Board(node->board);
-			
-			int moveProp = childBoard->putPiece(i, j, player);
-			if (moveProp != 0)
+			this->pushMove(moves[i], player);
+			if (this->canReduce(moves, numMoves, i, depth))
 			{
-				this->numNodesExpanded++;
-				Node * child = new Node(childBoard,i,j);
-				
-				// v = Min(v, Max-Value(Succ(node, action), alpha, beta)) 
-				v = min(v, abMax(child, nextPlayer, alpha, beta, depth+1));
-				
-				//Best Move pushed forward, worst move pushed backward
-				if (moveProp == 2 && node->children.empty() == false) 
-					node->children.insert(node->children.begin(), child);
-				else if (moveProp == 2 && node->children.empty() == true) 
-					node->children.push_back(child);
-				else 
-					node->children.push_back(child);
-				
-				//if v <= alpha return v
-				if (v <= alpha)
+				//search a late, low-value para drop one ply shallower first.
+				STATS(stats.reductions++);
+				this->nextReduced = true;
+				childValue = abMax(child, nextPlayer, alpha, beta, depth+2);
+				//if it still looks good enough, search it again at full depth.
+				if (childValue < beta)
 				{
-					node->value = v;
-					return node->value;
+					STATS(stats.researches++);
+					this->clearChildren(child);
+					childValue = abMax(child, nextPlayer, alpha, beta, depth+1);
 				}
-				//beta= Min(beta, v) 
-				beta = min(beta, v);
 			}
 			else
-			{
-				delete childBoard;
-			}
+				childValue = abMax(child, nextPlayer, alpha, beta, depth+1);
+			this->popMove();
+		}
+		else
+		{
+			this->extendLeaf(child, position, moves[i], player, alpha, beta);
+			childValue = child->value;
+			this->traceLeaf(child, position, nextPlayer, alpha, beta);
+		}
+		if (childValue < v)
+			bestCell = moves[i].cell;
+		v = min(v, childValue);
+		
+		//if v <= alpha return v
+		if (v <= alpha)
+		{
+			STATS(stats.betaCutoffs++);
+			STATS(if (node->children.size() == 1) stats.firstMoveCutoffs++);
+			node->value = v;
+			this->storeCache(position, player, originalAlpha, originalBeta, depth, v, bestCell);
+			return this->traceExit(node->value, TreeDump::CUTOFF);
 		}
+		//beta= Min(beta, v) 
+		beta = min(beta, v);
 	}
 	//end for
 	//return v
 	node->value = v;
-	return node->value;
+	this->storeCache(position, player, originalAlpha, originalBeta, depth, v, bestCell);
+	return this->traceExit(node->value, aborted ? TreeDump::STOPPED : TreeDump::COMPLETE);
 }
 
 /**
@@ -393,7 +569,8 @@ void Minimax::chooseNextMove(int & row, int & col)
 	
 	//if there is more than one 1 child whose values are equal to 
 	//the head's value, randomly pick one of these children.
-	int randIndex = rand() % ((int)listOfBestMoveIndices.size());
+	int random = (options.randomState != NULL) ? rand_r(options.randomState) : rand();
+	int randIndex = random % ((int)listOfBestMoveIndices.size());
 	Node * randChild = head->children.at( listOfBestMoveIndices.at(randIndex) );
 	//choose the move the AI must make based on the chosen child node.
 	row = randChild->rowMove;
@@ -408,3 +585,528 @@ int Minimax::getNumNodes()
 {
 	return this->numNodesExpanded;
 }
+
+/**
+ * Getter function
+ * 
+ * @return True if the search was stopped before it finished,
+ *         in which case the tree must not be used to choose a move.
+ */
+bool Minimax::wasAborted()
+{
+	return this->aborted;
+}
+
+/**
+ * Checks the stop flag, the deadline and the budgets of the search
+ * settings and remembers if any of them ever stopped the search. The clock is only
+ * read once every few calls, since this is called at every node.
+ * 
+ * @return True if the search must stop
+ */
+bool Minimax::stopRequested()
+{
+	if (this->options.stop != NULL && this->options.stop->load())
+		this->aborted = true;
+	if ((++numStopChecks & 63) == 0 && chrono::steady_clock::now() >= options.deadline)
+		this->aborted = true;
+	//the search also stops once it runs out of nodes or memory.
+	if ((options.maxNodes > 0 && numNodesExpanded >= options.maxNodes)
+	    || (options.maxBytes > 0 && bytesUsed >= options.maxBytes))
+	{
+		stats.budgetHit = true;
+		this->aborted = true;
+	}
+	return this->aborted;
+}
+
+/**
+ * Getter function
+ * 
+ * @return stats Statistics of the search, which are all 0
+ *         unless they are compiled in.
+ */
+const SearchStats & Minimax::getStats()
+{
+	return this->stats;
+}
+
+/**
+ * Counts a node visited at some depth of the search.
+ * 
+ * @param depth Depth of the node, the root being depth 0
+ */
+void Minimax::countNode(int depth)
+{
+	if (depth >= SearchStats::MAX_PLY)
+		depth = SearchStats::MAX_PLY - 1;
+	stats.nodesPerPly[depth]++;
+	if (depth > stats.maxPly)
+		stats.maxPly = depth;
+}
+
+/**
+ * Makes the child of a node for one of the moves found by the move generator.
+ * A child at the maximum depth, or whose game is over, is a leaf: its value
+ * comes straight from the move's score change and it gets no Board at all.
+ * 
+ * @param node Node whose child is made
+ * @param position Position of node's Board
+ * @param move Move that leads from node to the child
+ * @param player Player that makes the move
+ * @param depth Depth of node
+ * 
+ * @return Node The child, whose board is NULL if it is a leaf
+ */
+Minimax::Node * Minimax::makeChild(Node * node, const Position & position, const Move & move,
+                                   char player, int depth)
+{
+	//account for this node's creation.
+	this->numNodesExpanded++;
+	int row = move.cell / layout.size;
+	int col = move.cell % layout.size;
+	bool gameOver = (__builtin_popcountll(position.emptyCells(layout)) == 1);
+	if (gameOver == false && depth + 1 < options.maxDepth)
+	{
+		Board * childBoard = new Board(node->board);
+		childBoard->putPiece(row, col, player);
+		Node * child = new Node(childBoard, row, col);
+		this->account(this->nodeBytes(child));
+		return child;
+	}
+	
+	Node * child = new Node(NULL, row, col);
+	this->account(this->nodeBytes(child));
+	STATS(this->countNode(depth + 1));
+	int diff = position.scoreDiff(layout) + ((player == MAX) ? move.delta : -move.delta);
+	if (gameOver)
+	{
+		STATS(stats.terminalNodes++);
+		//utility function
+		if (diff > 0) child->value = 9001;
+		else if (diff == 0) child->value = 0;
+		else child->value = -9001;
+	}
+	else
+	{
+		STATS(stats.leafEvals++);
+		//utility function
+		child->value = diff;
+		//with the learned correction of the child's position.
+		if (options.network != NULL)
+		{
+			Network::Accumulator accumulator;
+			options.network->update(accumulators.back(), move, player, accumulator);
+			child->value += options.network->evaluate(accumulator, (player == MAX) ? MIN : MAX);
+		}
+	}
+	return child;
+}
+
+/**
+ * Frees all of a node's children, but not the node itself.
+ * 
+ * @param node The Node whose children are freed
+ */
+void Minimax::clearChildren(Node * node)
+{
+	while (node->children.empty() == false)
+	{
+		this->clear(node->children.back());
+		node->children.pop_back();
+	}
+}
+
+/**
+ * Tests if a node can be cut off because no sequence of moves in the
+ * remaining plies can bring its value into the alpha-beta window.
+ * Only Player Blue's moves raise Blue's score minus Green's, and each
+ * by at most the swing of the cell taken, so the value can rise by at
+ * most the largest swings of the empty cells, one per Blue move.
+ * The same holds for Player Green lowering it. If the game could end
+ * within the remaining plies, its utility is not bounded that way,
+ * so no cutoff is made.
+ * 
+ * @param position Position of the node
+ * @param player Player to move at the node
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ * @param depth Depth of the node
+ * @param bound Int that will hold the bound to return for the node
+ * 
+ * @return True if the node can be cut off
+ */
+bool Minimax::boundCutoff(const Position & position, char player, int alpha, int beta,
+                          int depth, int & bound)
+{
+	int remaining = options.maxDepth - depth;
+	unsigned long long empty = position.emptyCells(layout);
+	int numEmpty = __builtin_popcountll(empty);
+	if (numEmpty <= remaining)
+		return false;
+	//the player to move makes the first, third, ... of the remaining moves.
+	int playerMoves = (remaining + 1) / 2;
+	int otherMoves = remaining / 2;
+	int blueMoves = (player == MAX) ? playerMoves : otherMoves;
+	int greenMoves = (player == MAX) ? otherMoves : playerMoves;
+	
+	//find the largest swings among the empty cells.
+	int swings[Layout::MAX_CELLS];
+	int numSwings = 0;
+	while (empty != 0)
+	{
+		int cell = __builtin_ctzll(empty);
+		empty &= empty - 1;
+		swings[numSwings++] = layout.swing[cell];
+	}
+	int numLargest = max(blueMoves, greenMoves);
+	partial_sort(swings, swings + numLargest, swings + numSwings, greater<int>());
+	
+	int diff = position.scoreDiff(layout);
+	int upper = diff;
+	int lower = diff;
+	for (int i = 0; i < blueMoves; i++) upper += swings[i];
+	for (int i = 0; i < greenMoves; i++) lower -= swings[i];
+	if (upper <= alpha)
+	{
+		bound = upper;
+		return true;
+	}
+	if (lower >= beta)
+	{
+		bound = lower;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Tests if a child may be searched one ply shallower first. That is the
+ * case for para drops (not blitzes) that are searched late and are worth
+ * less than the average move, as long as the child still gets searched.
+ * 
+ * @param moves Moves of the node, in the order they are searched
+ * @param numMoves Number of moves
+ * @param index Index of the child's move
+ * @param depth Depth of the node
+ * 
+ * @return True if the child's search may be reduced
+ */
+bool Minimax::canReduce(const Move * moves, int numMoves, int index, int depth)
+{
+	if (options.enableLateMoveReductions == false || index < LATE_MOVE_INDEX 
+	    || moves[index].blitz || depth + 2 > options.maxDepth)
+		return false;
+	int totalDelta = 0;
+	for (int i = 0; i < numMoves; i++)
+		totalDelta += moves[i].delta;
+	return moves[index].delta * numMoves < totalDelta;
+}
+
+/**
+ * Updates the Network's accumulator for a move into a child
+ * that is searched, if a Network is used.
+ * 
+ * @param move Move that leads to the child
+ * @param player Player that makes the move
+ */
+void Minimax::pushMove(const Move & move, char player)
+{
+	if (options.network == NULL)
+		return;
+	accumulators.push_back(Network::Accumulator());
+	options.network->update(accumulators[accumulators.size() - 2], move, player, accumulators.back());
+}
+
+/**
+ * Undoes pushMove once the child has been searched.
+ */
+void Minimax::popMove()
+{
+	if (options.network != NULL)
+		accumulators.pop_back();
+}
+
+/**
+ * Finds the Network's correction of the current node's value.
+ * 
+ * @param playerToMove Player to move at the current node
+ * 
+ * @return int The correction, or 0 if no Network is used
+ */
+int Minimax::correction(char playerToMove)
+{
+	if (options.network == NULL)
+		return 0;
+	return options.network->evaluate(accumulators.back(), playerToMove);
+}
+
+/**
+ * Streams the start of a node's search to the dump, if there is one.
+ * 
+ * @param node Node whose search starts
+ * @param player Player to move at the node
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ */
+void Minimax::traceEnter(Node * node, char player, int alpha, int beta)
+{
+	bool reduced = this->nextReduced;
+	this->nextReduced = false;
+	if (options.dump == NULL)
+		return;
+	//cells are numbered on a board of the largest size, like the dump's readers expect.
+	int cell = (node == this->head) ? -1 : node->rowMove * Layout::MAX_SIZE + node->colMove;
+	options.dump->enter(cell, player, alpha, beta, reduced);
+}
+
+/**
+ * Streams the end of the search of the node entered last
+ * to the dump, if there is one.
+ * 
+ * @param value Value of the node
+ * @param reason Why the search of the node ended (see TreeDump)
+ * 
+ * @return int The value, so that it can be returned right away
+ */
+int Minimax::traceExit(int value, char reason)
+{
+	if (options.dump != NULL)
+		options.dump->exit(value, reason);
+	return value;
+}
+
+/**
+ * Streams a leaf child, which makeChild evaluated without
+ * searching it, to the dump, if there is one.
+ * 
+ * @param child The leaf child
+ * @param position Position of the child's parent
+ * @param player Player to move at the child
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ */
+void Minimax::traceLeaf(Node * child, const Position & position, char player, int alpha, int beta)
+{
+	if (options.dump == NULL)
+		return;
+	bool gameOver = (__builtin_popcountll(position.emptyCells(layout)) == 1);
+	options.dump->leaf(child->rowMove * Layout::MAX_SIZE + child->colMove, player, alpha, beta,
+	                   child->value, gameOver ? TreeDump::TERMINAL : TreeDump::LEAF);
+}
+
+/**
+ * Finds the bytes a node takes up: the node itself, its place
+ * in its parent's children, and its Board, if it has one.
+ * 
+ * @param node The node
+ * 
+ * @return long long Number of bytes
+ */
+long long Minimax::nodeBytes(const Node * node)
+{
+	long long bytes = sizeof(Node) + sizeof(Node *);
+	if (node->board != NULL)
+		bytes += sizeof(Board);
+	return bytes;
+}
+
+/**
+ * Counts bytes that the search allocated or, if negative, freed,
+ * and remembers the most bytes ever used at once.
+ * 
+ * @param bytes Number of bytes
+ */
+void Minimax::account(long long bytes)
+{
+	this->bytesUsed += bytes;
+	if (this->bytesUsed > stats.peakBytes)
+		stats.peakBytes = this->bytesUsed;
+}
+
+/**
+ * Looks up a node's position in the position cache. Its value can be used
+ * if it was searched at least as deep as the node would be, and it is exact
+ * or a bound that already falls outside of the alpha-beta window. The root
+ * is always searched, since a move has to be chosen among its children.
+ * 
+ * @param position Position of the node
+ * @param player Player to move at the node
+ * @param alpha Best alternative available to the Max player 
+ * @param beta Best alternative available to the Min player 
+ * @param depth Depth of the node
+ * @param value Int that will hold the cached value, if it can be used
+ * @param bestCell Int that will hold the cell of the cached best move, or -1
+ * 
+ * @return True if the cached value can be used
+ */
+bool Minimax::probeCache(const Position & position, char player, int alpha, int beta,
+                         int depth, int & value, int & bestCell)
+{
+	if (options.cache == NULL)
+		return false;
+	int cachedValue = 0; int cachedDepth = 0; char bound = 0;
+	if (options.cache->probe(layoutKey, position, player, cachedValue, cachedDepth, bound, bestCell)
+	    && depth > 0 && cachedDepth >= options.maxDepth - depth
+	    && (bound == PositionCache::EXACT
+	        || (bound == PositionCache::LOWER && cachedValue >= beta)
+	        || (bound == PositionCache::UPPER && cachedValue <= alpha)))
+	{
+		STATS(stats.hashHits++);
+		value = cachedValue;
+		return true;
+	}
+	STATS(stats.hashMisses++);
+	return false;
+}
+
+/**
+ * Saves a node's value to the position cache, marking whether it is exact
+ * or only a bound. Nothing is saved if the search was stopped, since the
+ * value may then be wrong.
+ * 
+ * @param position Position of the node
+ * @param player Player to move at the node
+ * @param alpha Alpha when the node was entered
+ * @param beta Beta when the node was entered
+ * @param depth Depth of the node
+ * @param value Value of the node
+ * @param bestCell Cell of the node's best move
+ */
+void Minimax::storeCache(const Position & position, char player, int alpha, int beta,
+                         int depth, int value, int bestCell)
+{
+	if (options.cache == NULL || this->aborted)
+		return;
+	char bound = PositionCache::EXACT;
+	if (value <= alpha) bound = PositionCache::UPPER;
+	else if (value >= beta) bound = PositionCache::LOWER;
+	options.cache->store(layoutKey, position, player, value, options.maxDepth - depth, bound, bestCell);
+}
+
+/**
+ * Moves the move of a cell to the front of the moves,
+ * keeping the others in the same order.
+ * 
+ * @param moves Moves to reorder
+ * @param numMoves Number of moves
+ * @param cell Cell of the move to put first, or -1 to keep the order
+ */
+void Minimax::moveToFront(Move * moves, int numMoves, int cell)
+{
+	for (int i = 0; i < numMoves; i++)
+	{
+		if (moves[i].cell == cell)
+		{
+			rotate(moves, moves + i, moves + i + 1);
+			return;
+		}
+	}
+}
+
+/**
+ * Searches a leaf child further with quiescence search, if it is enabled
+ * and the child's game is not over.
+ * 
+ * @param child Leaf child, whose value is replaced
+ * @param position Position of the child's parent
+ * @param move Move that leads to the child
+ * @param player Player that makes the move
+ * @param alpha Best alternative available to the Max player 
+ * @param beta Best alternative available to the Min player 
+ */
+void Minimax::extendLeaf(Node * child, const Position & position, const Move & move,
+                         char player, int alpha, int beta)
+{
+	if (options.enableQuiescence == false || __builtin_popcountll(position.emptyCells(layout)) == 1)
+		return;
+	Position childPosition = position;
+	childPosition.makeMove(move, player);
+	child->value = this->quiesce(childPosition, (player == MAX) ? MIN : MAX, alpha, beta, 0);
+}
+
+/**
+ * Quiescence search: past the maximum depth, only Death Blitzes are
+ * searched, biggest gain first, until no blitz is left or
+ * QUIESCENCE_DEPTH more plies are searched. The player to move may
+ * also stand pat, as if it made a para drop that leaves the score as
+ * it is, so the material count is a bound on the position's value.
+ * A blitz is skipped when even its gain cannot bring the score into
+ * the alpha-beta window. The replies can only take score back, so
+ * this is exact unless the blitz ends the game.
+ * 
+ * @param position Position to search
+ * @param player Player to move
+ * @param alpha Best alternative available to the Max player 
+ * @param beta Best alternative available to the Min player 
+ * @param ply Number of plies searched past the maximum depth
+ * 
+ * @return int Value of the position
+ */
+int Minimax::quiesce(const Position & position, char player, int alpha, int beta, int ply)
+{
+	STATS(stats.quiescenceNodes++);
+	int numEmpty = __builtin_popcountll(position.emptyCells(layout));
+	int standPat = position.scoreDiff(layout);
+	if (numEmpty == 0)
+	{
+		//utility function
+		if (standPat > 0) return 9001;
+		else if (standPat == 0) return 0;
+		else return -9001;
+	}
+	if (ply == QUIESCENCE_DEPTH)
+		return standPat;
+	if (player == MAX)
+	{
+		if (standPat >= beta)
+			return standPat;
+		alpha = max(alpha, standPat);
+	}
+	else
+	{
+		if (standPat <= alpha)
+			return standPat;
+		beta = min(beta, standPat);
+	}
+	
+	//only keep the blitzes, biggest gain first.
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	int numBlitzes = 0;
+	for (int i = 0; i < numMoves; i++)
+		if (moves[i].blitz)
+			moves[numBlitzes++] = moves[i];
+	Position::orderMoves(moves, numBlitzes);
+	
+	int v = standPat;
+	char nextPlayer = (player == MAX) ? MIN : MAX;
+	for (int i = 0; i < numBlitzes; i++)
+	{
+		//the blitzes after this one gain even less.
+		int reach = (player == MAX) ? standPat + moves[i].delta : standPat - moves[i].delta;
+		if (numEmpty > 1 && ((player == MAX) ? reach <= alpha : reach >= beta))
+		{
+			STATS(stats.deltaPrunes++);
+			break;
+		}
+		Position child = position;
+		child.makeMove(moves[i], player);
+		int childValue = this->quiesce(child, nextPlayer, alpha, beta, ply + 1);
+		if (player == MAX)
+		{
+			v = max(v, childValue);
+			if (v >= beta)
+				return v;
+			alpha = max(alpha, v);
+		}
+		else
+		{
+			v = min(v, childValue);
+			if (v <= alpha)
+				return v;
+			beta = min(beta, v);
+		}
+	}
+	return v;
+}
@@ -5,8 +5,15 @@
 #ifndef MINIMAX_H
 #define MINIMAX_H
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include "board.h"
+#include "network.h"
+#include "poscache.h"
+#include "position.h"
+#include "searchstats.h"
+#include "treedump.h"
 
 using namespace std;
 
@@ -26,6 +33,10 @@ class Minimax
 		static const char MAX = 'B';
 		static const char MIN = 'G';
 		static const int INFINITY = 1000000;
+		//late move reductions only apply from this child on.
+		static const int LATE_MOVE_INDEX = 3;
+		//quiescence search goes at most this many plies past the maximum depth.
+		static const int QUIESCENCE_DEPTH = 4;
 		
 		/**
 		 * This class is a node of a minimax tree
@@ -42,8 +53,52 @@ class Minimax
 				int colMove;
 				vector<Node *> children;
 		};
+		
+		/**
+		 * This class holds the settings of one search.
+		 * @see minimax.cpp for function definitions.
+		 */
+		class Options
+		{
+			public:
+				Options(bool enableAlphaBeta);
+				
+				bool enableAlphaBeta;
+				//cut off nodes that cannot reach the alpha-beta window
+				//even with the largest possible score swing. it is not
+				//used with a Network or with quiescence search.
+				bool enableBoundPruning;
+				//search late, low-value para drops one ply shallower first.
+				bool enableLateMoveReductions;
+				//keep searching Death Blitzes past the maximum depth, so leaves
+				//are only evaluated once no big flip is pending. only alpha-beta
+				//searches without a Network use it.
+				bool enableQuiescence;
+				//depth at which nodes are evaluated by the heuristic.
+				int maxDepth;
+				//set by another thread to abandon the search early.
+				const atomic<bool> * stop;
+				//the search is abandoned once this time is reached.
+				chrono::steady_clock::time_point deadline;
+				//learned correction of the leaves' values, or NULL for none.
+				const Network * network;
+				//where the visited nodes are streamed to, or NULL for nowhere.
+				TreeDump * dump;
+				//the search stops once it has made this many nodes, or once its
+				//nodes, Boards and caches take up this many bytes (0 for no limit).
+				//a search can go past a budget by the children of one node.
+				long long maxNodes;
+				long long maxBytes;
+				//results of earlier searches, possibly by other runs, or NULL for
+				//none. only alpha-beta searches without a Network use it.
+				PositionCache * cache;
+				//state of rand_r() for breaking ties between equally good
+				//moves, or NULL to use rand(), which threads cannot share.
+				unsigned int * randomState;
+		};
 	
 		Minimax(char currPlayer, const Board * currBoard, bool enableAlphaBeta);
+		Minimax(char currPlayer, const Board * currBoard, const Options & options);
 		~Minimax();
 		void clear(Node * node);
 		
@@ -53,13 +108,53 @@ class Minimax
 		int abMax(Node * node, char player, int alpha, int beta, int depth);
 		int abMin(Node * node, char player, int alpha, int beta, int depth);
 		
-		void chooseNextMove(int & row, int & col);;
+		void chooseNextMove(int & row, int & col);
 		
 		int getNumNodes();
+		bool wasAborted();
+		const SearchStats & getStats();
 		
 	private:
 		Node * head;
 		int numNodesExpanded;
+		Options options;
+		bool aborted;
+		unsigned int numStopChecks;
+		SearchStats stats;
+		Layout layout;
+		//bytes taken up by the tree and the caches right now.
+		long long bytesUsed;
+		//the Network's accumulators of the nodes from the root to the current node.
+		vector<Network::Accumulator> accumulators;
+		//true if the next node entered is searched one ply shallower.
+		bool nextReduced;
+		//hash of the layout for the position cache.
+		unsigned long long layoutKey;
+		
+		bool stopRequested();
+		void countNode(int depth);
+		Node * makeChild(Node * node, const Position & position, const Move & move,
+		                 char player, int depth);
+		void clearChildren(Node * node);
+		bool boundCutoff(const Position & position, char player, int alpha, int beta,
+		                 int depth, int & bound);
+		bool canReduce(const Move * moves, int numMoves, int index, int depth);
+		void pushMove(const Move & move, char player);
+		void popMove();
+		int correction(char playerToMove);
+		void extendLeaf(Node * child, const Position & position, const Move & move,
+		                char player, int alpha, int beta);
+		int quiesce(const Position & position, char player, int alpha, int beta, int ply);
+		void traceEnter(Node * node, char player, int alpha, int beta);
+		int traceExit(int value, char reason);
+		void traceLeaf(Node * child, const Position & position, char player, int alpha, int beta);
+		bool probeCache(const Position & position, char player, int alpha, int beta,
+		                int depth, int & value, int & bestCell);
+		void storeCache(const Position & position, char player, int alpha, int beta,
+		                int depth, int value, int bestCell);
+		static void moveToFront(Move * moves, int numMoves, int cell);
+		long long nodeBytes(const Node * node);
+		void account(long long bytes);
 };
 
 #endif
@@ -0,0 +1,364 @@
+/**
+ * @file multipv.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "multipv.h"
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include "minimax.h"
+
+using namespace std;
+
+/**
+ * Constructor that searches the position for its best moves.
+ *
+ * @param currPlayer Char of the player to move
+ * @param currBoard Board to search
+ * @param numLines Number of best moves to find
+ * @param depth Depth at which nodes are evaluated by the heuristic, the root being depth 0
+ */
+MultiPV::MultiPV(char currPlayer, const Board * currBoard, int numLines, int depth)
+	: layout(currBoard)
+{
+	this->currPlayer = currPlayer;
+	this->maxDepth = depth;
+	this->numNodes = 1;
+	Entry empty;
+	memset(&empty, 0, sizeof(empty));
+	empty.bound = EMPTY;
+	table.assign(1 << TABLE_BITS, empty);
+	STATS(chrono::steady_clock::time_point begin = chrono::steady_clock::now());
+
+	Position position(currBoard);
+	if (position.isGameOver(layout) || numLines < 1 || depth < 1)
+		return;
+	STATS(stats.interiorNodes++);
+	char nextPlayer = (currPlayer == Minimax::MAX) ? Minimax::MIN : Minimax::MAX;
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, currPlayer, moves);
+	Position::orderMoves(moves, numMoves);
+	Variation variation;
+	for (int i = 0; i < numMoves; i++)
+	{
+		Position child = position;
+		child.makeMove(moves[i], currPlayer);
+		int value = 0;
+		//until there are enough lines, every move gets its exact value.
+		if ((int)lines.size() < numLines)
+			value = this->search(child, nextPlayer, -1*Minimax::INFINITY, Minimax::INFINITY, 1, variation);
+		else
+		{
+			//otherwise, a null window first tells if the move beats the worst line.
+			//if it does, it is searched again for its exact value.
+			int worst = lines.back().value;
+			if (currPlayer == Minimax::MAX)
+			{
+				if (this->search(child, nextPlayer, worst, worst + 1, 1, variation) <= worst)
+					continue;
+				value = this->search(child, nextPlayer, worst, Minimax::INFINITY, 1, variation);
+			}
+			else
+			{
+				if (this->search(child, nextPlayer, worst - 1, worst, 1, variation) >= worst)
+					continue;
+				value = this->search(child, nextPlayer, -1*Minimax::INFINITY, worst, 1, variation);
+			}
+		}
+		this->addLine(moves[i], value, variation, numLines);
+	}
+	STATS(stats.iterationTimes.push_back(
+		chrono::duration<double>(chrono::steady_clock::now() - begin).count()));
+}
+
+/**
+ * Getter function
+ *
+ * @return int Number of lines found, which is less than asked for
+ *         if the position has fewer moves
+ */
+int MultiPV::getNumLines()
+{
+	return (int)this->lines.size();
+}
+
+/**
+ * Getter function
+ *
+ * @param index Index of the line, 0 being the best move
+ *
+ * @return Line One of the best moves
+ */
+const MultiPV::Line & MultiPV::getLine(int index)
+{
+	return this->lines.at(index);
+}
+
+/**
+ * Function that stores the coordinate of a near-best move to the params.
+ * A move is picked at random among the lines whose value is within
+ * margin of the best value, so with a margin of 0 only best moves are
+ * picked. The position's game must not be over.
+ *
+ * @param row Int that will hold the row of the move to make.
+ * @param col Int that will hold the col of the move to make.
+ * @param margin Most that the picked move's value can be worse than the best value
+ */
+void MultiPV::chooseNextMove(int & row, int & col, int margin)
+{
+	int numCandidates = 0;
+	while (numCandidates < (int)lines.size()
+	       && abs(lines[numCandidates].value - lines[0].value) <= margin)
+	{
+		numCandidates++;
+	}
+	const Line & line = lines.at(rand() % numCandidates);
+	row = line.row;
+	col = line.col;
+}
+
+/**
+ * Displays each line with its value and its principal variation.
+ *
+ * @param out Stream to display the lines on
+ */
+void MultiPV::printLines(ostream & out)
+{
+	for (unsigned int i = 0; i < lines.size(); i++)
+	{
+		out << i + 1 << ". Row: " << lines[i].row << ", col: " << lines[i].col
+		    << " (value " << lines[i].value << ")";
+		for (unsigned int j = 0; j < lines[i].variation.size(); j++)
+		{
+			int cell = lines[i].variation[j];
+			out << " " << cell / layout.size << "," << cell % layout.size;
+		}
+		out << endl;
+	}
+}
+
+/**
+ * Getter function
+ *
+ * @return numNodes Number of nodes searched, counting each search of a node
+ */
+int MultiPV::getNumNodes()
+{
+	return this->numNodes;
+}
+
+/**
+ * Getter function
+ *
+ * @return stats Statistics of the search, which are all 0
+ *         unless they are compiled in.
+ */
+const SearchStats & MultiPV::getStats()
+{
+	return this->stats;
+}
+
+/**
+ * Recursive helper function which searches a node with alpha-beta pruning
+ * and the cache. A node whose window is wider than a null window is on a
+ * principal variation: it never takes its value from the cache, and its
+ * children after the first are tried with a null window before they are
+ * searched with the whole window. The value is exact if it is inside the
+ * window; otherwise it is only a bound, like in Minimax::abMax and abMin.
+ *
+ * @param position Position of the node
+ * @param player Current player at a depth within the search
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ * @param depth Int whose value is a base case
+ * @param variation Variation that will hold the node's principal variation
+ *
+ * @return int Minimax value of node
+ */
+int MultiPV::search(const Position & position, char player, int alpha, int beta, int depth,
+                    Variation & variation)
+{
+	numNodes++;
+	variation.numMoves = 0;
+	//BASE CASES================================================================
+	//if this node's game state is "Game Over".
+	if (position.isGameOver(layout))
+	{
+		STATS(stats.terminalNodes++);
+		int diff = position.scoreDiff(layout);
+		//utility function
+		if (diff > 0) return 9001;
+		else if (diff == 0) return 0;
+		else return -9001;
+	}
+	//if this node is at the maximum depth of the search.
+	if (depth == maxDepth)
+	{
+		STATS(stats.leafEvals++);
+		//utility function
+		return position.scoreDiff(layout);
+	}
+
+	//RECURSIVE CASE============================================================
+	//a cached value can be used if it is exact, or if it is
+	//a bound that already falls outside of the window.
+	int remaining = maxDepth - depth;
+	bool onVariation = (beta - alpha > 1);
+	int bestCell = -1;
+	const Entry & entry = this->probe(position);
+	if (entry.bound != EMPTY && entry.blue == position.blue && entry.green == position.green
+	    && entry.remaining == remaining)
+	{
+		if (onVariation == false && (entry.bound == EXACT
+		    || (entry.bound == LOWER && entry.value >= beta)
+		    || (entry.bound == UPPER && entry.value <= alpha)))
+		{
+			STATS(stats.hashHits++);
+			return entry.value;
+		}
+		bestCell = entry.bestCell;
+	}
+	STATS(stats.hashMisses++);
+	STATS(stats.interiorNodes++);
+
+	//search the cached best move first, then the best looking moves.
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	Position::orderMoves(moves, numMoves);
+	for (int i = 1; i < numMoves; i++)
+	{
+		if (moves[i].cell == bestCell)
+		{
+			Move best = moves[i];
+			memmove(moves + 1, moves, i * sizeof(Move));
+			moves[0] = best;
+			break;
+		}
+	}
+
+	int originalAlpha = alpha;
+	int originalBeta = beta;
+	char nextPlayer = (player == Minimax::MAX) ? Minimax::MIN : Minimax::MAX;
+	int v = (player == Minimax::MAX) ? -1*Minimax::INFINITY : Minimax::INFINITY;
+	bestCell = -1;
+	Variation childVariation;
+	for (int i = 0; i < numMoves; i++)
+	{
+		Position child = position;
+		child.makeMove(moves[i], player);
+		int childValue = 0;
+		if (i == 0 || onVariation == false)
+			childValue = this->search(child, nextPlayer, alpha, beta, depth + 1, childVariation);
+		else if (player == Minimax::MAX)
+		{
+			//only search the whole window if the move can beat alpha.
+			childValue = this->search(child, nextPlayer, alpha, alpha + 1, depth + 1, childVariation);
+			if (childValue > alpha && childValue < beta)
+				childValue = this->search(child, nextPlayer, alpha, beta, depth + 1, childVariation);
+		}
+		else
+		{
+			//only search the whole window if the move can beat beta.
+			childValue = this->search(child, nextPlayer, beta - 1, beta, depth + 1, childVariation);
+			if (childValue < beta && childValue > alpha)
+				childValue = this->search(child, nextPlayer, alpha, beta, depth + 1, childVariation);
+		}
+
+		//the principal variation goes through the best child.
+		if (bestCell < 0 || (player == Minimax::MAX && childValue > v)
+		    || (player == Minimax::MIN && childValue < v))
+		{
+			v = childValue;
+			bestCell = moves[i].cell;
+			variation.numMoves = childVariation.numMoves + 1;
+			variation.cells[0] = moves[i].cell;
+			memcpy(variation.cells + 1, childVariation.cells, childVariation.numMoves);
+		}
+		if (player == Minimax::MAX)
+		{
+			if (v >= beta)
+			{
+				STATS(stats.betaCutoffs++);
+				break;
+			}
+			alpha = max(alpha, v);
+		}
+		else
+		{
+			if (v <= alpha)
+			{
+				STATS(stats.betaCutoffs++);
+				break;
+			}
+			beta = min(beta, v);
+		}
+	}
+
+	//cache the value, marking whether it is exact or only a bound.
+	Entry & slot = this->probe(position);
+	slot.blue = position.blue;
+	slot.green = position.green;
+	slot.value = v;
+	slot.remaining = remaining;
+	slot.bestCell = bestCell;
+	if (v <= originalAlpha) slot.bound = UPPER;
+	else if (v >= originalBeta) slot.bound = LOWER;
+	else slot.bound = EXACT;
+	return v;
+}
+
+/**
+ * Finds the cache entry a position belongs in. The entry may
+ * hold another position, or nothing at all.
+ *
+ * @param position Position to look up
+ *
+ * @return Entry The position's cache entry
+ */
+MultiPV::Entry & MultiPV::probe(const Position & position)
+{
+	unsigned long long hash = (position.blue * 0x9E3779B97F4A7C15ULL)
+	                          ^ (position.green * 0xC2B2AE3D27D4EB4FULL);
+	return table[hash >> (64 - TABLE_BITS)];
+}
+
+/**
+ * Adds a root move to the lines, which are kept best first,
+ * and drops the worst line if there are too many.
+ *
+ * @param move Move of the root
+ * @param value Exact value of the move
+ * @param variation Principal variation after the move
+ * @param numLines Number of lines to keep
+ */
+void MultiPV::addLine(const Move & move, int value, const Variation & variation, int numLines)
+{
+	Line line;
+	line.row = move.cell / layout.size;
+	line.col = move.cell % layout.size;
+	line.value = value;
+	line.variation.push_back(move.cell);
+	for (int i = 0; i < variation.numMoves; i++)
+		line.variation.push_back(variation.cells[i]);
+
+	unsigned int index = lines.size();
+	while (index > 0 && this->isBetter(value, lines[index - 1].value))
+		index--;
+	lines.insert(lines.begin() + index, line);
+	if ((int)lines.size() > numLines)
+		lines.pop_back();
+}
+
+/**
+ * Tests if a value of a root move is better than another
+ * for the player to move at the root.
+ *
+ * @param value Value to test
+ * @param other Value to compare with
+ *
+ * @return True if value is strictly better
+ */
+bool MultiPV::isBetter(int value, int other)
+{
+	return (currPlayer == Minimax::MAX) ? value > other : value < other;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file multipv.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef MULTIPV_H
+#define MULTIPV_H
+
+#include <ostream>
+#include <vector>
+#include "board.h"
+#include "position.h"
+#include "searchstats.h"
+
+using namespace std;
+
+/**
+ * This class finds the best few moves of a position, each with its exact
+ * Minimax value and its principal variation: the moves both players make
+ * if they play best from there on. Plain alpha-beta search only knows the
+ * exact value of the best move, since the others are cut off as soon as
+ * they are known to be worse.
+ *
+ * Each move is first searched with a null window, which only tells if it
+ * beats the worst of the lines found so far. Only the moves that do are
+ * searched again for their exact value. All of these searches share one
+ * cache of positions, so a position reached through several root moves
+ * is searched once.
+ */
+class MultiPV
+{
+	public:
+		/**
+		 * This class is one of the best moves, with its exact Minimax value.
+		 * Its variation starts with the move itself.
+		 */
+		class Line
+		{
+			public:
+				int row;
+				int col;
+				int value;
+				//cells of the moves of the principal variation, in order.
+				vector<int> variation;
+		};
+
+		MultiPV(char currPlayer, const Board * currBoard, int numLines, int depth);
+
+		int getNumLines();
+		const Line & getLine(int index);
+		void chooseNextMove(int & row, int & col, int margin);
+		void printLines(ostream & out);
+
+		int getNumNodes();
+		const SearchStats & getStats();
+
+	private:
+		static const int TABLE_BITS = 17;
+		//how the value in a cache entry relates to the position's value.
+		static const char EMPTY = 0;
+		static const char EXACT = 1;
+		static const char LOWER = 2;
+		static const char UPPER = 3;
+
+		/**
+		 * This class is a cache entry: the value of a position
+		 * searched to some depth and the best move found there.
+		 */
+		class Entry
+		{
+			public:
+				unsigned long long blue;
+				unsigned long long green;
+				int value;
+				char remaining;
+				char bound;
+				signed char bestCell;
+		};
+
+		/**
+		 * This class is the principal variation below a node of the search.
+		 */
+		class Variation
+		{
+			public:
+				int numMoves;
+				unsigned char cells[Layout::MAX_CELLS];
+		};
+
+		Layout layout;
+		char currPlayer;
+		int maxDepth;
+		vector<Line> lines;
+		vector<Entry> table;
+		int numNodes;
+		SearchStats stats;
+
+		int search(const Position & position, char player, int alpha, int beta, int depth,
+		           Variation & variation);
+		Entry & probe(const Position & position);
+		void addLine(const Move & move, int value, const Variation & variation, int numLines);
+		bool isBetter(int value, int other);
+};
+
+#endif
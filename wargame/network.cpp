@@ -0,0 +1,181 @@
+/**
+ * @file network.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "network.h"
+#include <fstream>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Constructor of a Network whose weights are all 0, which
+ * never corrects the material count.
+ */
+Network::Network()
+{
+	memset(hiddenBiases, 0, sizeof(hiddenBiases));
+	memset(hiddenWeights, 0, sizeof(hiddenWeights));
+	memset(outputWeights, 0, sizeof(outputWeights));
+	outputBiases[0] = 0;
+	outputBiases[1] = 0;
+	outputShift = 0;
+}
+
+/**
+ * Loads the weights from a weight file (see network.h). If the file
+ * cannot be read or does not fit this Network, the weights are unchanged.
+ *
+ * @param filename Name of the weight file
+ *
+ * @return True if the weights were loaded
+ */
+bool Network::load(const char * filename)
+{
+	ifstream in(filename, ios::binary);
+	char magic[8];
+	int32_t header[3];
+	in.read(magic, sizeof(magic));
+	in.read((char *)header, sizeof(header));
+	if (!in || memcmp(magic, "WARNNUE1", 8) != 0 || header[0] != NUM_INPUTS
+	    || header[1] != HIDDEN || header[2] < 0 || header[2] > 30)
+		return false;
+
+	//read everything before taking any of it.
+	int16_t biases[HIDDEN];
+	int16_t (* weights)[HIDDEN] = new int16_t[NUM_INPUTS][HIDDEN];
+	int8_t output[HIDDEN];
+	int32_t outputBias[2];
+	in.read((char *)biases, sizeof(biases));
+	in.read((char *)weights, sizeof(int16_t) * NUM_INPUTS * HIDDEN);
+	in.read((char *)output, sizeof(output));
+	in.read((char *)outputBias, sizeof(outputBias));
+	if (!in)
+	{
+		delete [] weights;
+		return false;
+	}
+	memcpy(hiddenBiases, biases, sizeof(hiddenBiases));
+	memcpy(hiddenWeights, weights, sizeof(hiddenWeights));
+	for (int i = 0; i < HIDDEN; i++)
+		outputWeights[i] = output[i];
+	outputBiases[0] = outputBias[0];
+	outputBiases[1] = outputBias[1];
+	outputShift = header[2];
+	delete [] weights;
+	return true;
+}
+
+/**
+ * Computes the accumulator of a position from scratch.
+ *
+ * @param position Position to compute the accumulator of
+ * @param accumulator Accumulator that will hold the sums
+ */
+void Network::refresh(const Position & position, Accumulator & accumulator) const
+{
+	memcpy(accumulator.sums, hiddenBiases, sizeof(accumulator.sums));
+	for (int p = 0; p < 2; p++)
+	{
+		unsigned long long pieces = (p == 0) ? position.blue : position.green;
+		while (pieces != 0)
+		{
+			int input = p * Layout::MAX_CELLS + __builtin_ctzll(pieces);
+			pieces &= pieces - 1;
+			for (int i = 0; i < HIDDEN; i++)
+				accumulator.sums[i] += hiddenWeights[input][i];
+		}
+	}
+}
+
+/**
+ * Computes the accumulator of a child position from its parent's:
+ * the moving player gains the cell taken and every flipped cell,
+ * and the opponent loses every flipped cell.
+ *
+ * @param parent Accumulator of the position before the move
+ * @param move Move that is made
+ * @param player Player that makes the move
+ * @param child Accumulator that will hold the sums after the move
+ */
+void Network::update(const Accumulator & parent, const Move & move, char player,
+                     Accumulator & child) const
+{
+	int mine = (player == 'B') ? 0 : Layout::MAX_CELLS;
+	int theirs = (player == 'B') ? Layout::MAX_CELLS : 0;
+#ifdef __SSE2__
+	//the sums stay in registers for the whole move.
+	__m128i sums[HIDDEN / 8];
+	for (int i = 0; i < HIDDEN / 8; i++)
+	{
+		sums[i] = _mm_add_epi16(_mm_loadu_si128((const __m128i *)parent.sums + i),
+		                        _mm_loadu_si128((const __m128i *)hiddenWeights[mine + move.cell] + i));
+	}
+	unsigned long long flipped = move.flipped;
+	while (flipped != 0)
+	{
+		int cell = __builtin_ctzll(flipped);
+		flipped &= flipped - 1;
+		for (int i = 0; i < HIDDEN / 8; i++)
+		{
+			sums[i] = _mm_add_epi16(sums[i], _mm_loadu_si128((const __m128i *)hiddenWeights[mine + cell] + i));
+			sums[i] = _mm_sub_epi16(sums[i], _mm_loadu_si128((const __m128i *)hiddenWeights[theirs + cell] + i));
+		}
+	}
+	for (int i = 0; i < HIDDEN / 8; i++)
+		_mm_storeu_si128((__m128i *)child.sums + i, sums[i]);
+#else
+	for (int i = 0; i < HIDDEN; i++)
+		child.sums[i] = parent.sums[i] + hiddenWeights[mine + move.cell][i];
+	unsigned long long flipped = move.flipped;
+	while (flipped != 0)
+	{
+		int cell = __builtin_ctzll(flipped);
+		flipped &= flipped - 1;
+		for (int i = 0; i < HIDDEN; i++)
+			child.sums[i] += hiddenWeights[mine + cell][i] - hiddenWeights[theirs + cell][i];
+	}
+#endif
+}
+
+/**
+ * Evaluates a position from its accumulator.
+ *
+ * @param accumulator Accumulator of the position
+ * @param playerToMove Player to move in the position
+ *
+ * @return int Correction to Player Blue's score minus Player Green's score
+ */
+int Network::evaluate(const Accumulator & accumulator, char playerToMove) const
+{
+	int32_t sum = 0;
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ceiling = _mm_set1_epi16(127);
+	__m128i total = zero;
+	for (int i = 0; i < HIDDEN / 8; i++)
+	{
+		__m128i clipped = _mm_loadu_si128((const __m128i *)accumulator.sums + i);
+		clipped = _mm_min_epi16(_mm_max_epi16(clipped, zero), ceiling);
+		total = _mm_add_epi32(total, _mm_madd_epi16(clipped,
+		                      _mm_loadu_si128((const __m128i *)outputWeights + i)));
+	}
+	//add up the four 32-bit lanes.
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+	sum = _mm_cvtsi128_si32(total);
+#else
+	for (int i = 0; i < HIDDEN; i++)
+	{
+		int clipped = accumulator.sums[i];
+		if (clipped < 0) clipped = 0;
+		if (clipped > 127) clipped = 127;
+		sum += clipped * outputWeights[i];
+	}
+#endif
+	sum += outputBiases[(playerToMove == 'B') ? 0 : 1];
+	return sum >> outputShift;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file network.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include <stdint.h>
+#include "position.h"
+
+/**
+ * This class is a small learned evaluation in the style of NNUE. It
+ * corrects Player Blue's score minus Player Green's score, so a Network
+ * whose weights are all 0 plays exactly like the material count.
+ *
+ * There is one input for each player and cell, which is 1 if the player
+ * controls the piece in the cell. The inputs feed HIDDEN neurons whose
+ * sums (the accumulator) are kept up to date move by move: a para drop
+ * adds one weight column, and each piece flipped by a Death Blitz swaps
+ * one column for another. A leaf is then evaluated by clipping the
+ * accumulator to [0, 127] and taking its dot product with the output
+ * weights. All of this is done in 16-bit integers, with SSE2 where the
+ * CPU has it.
+ *
+ * Weight files are little-endian binary files:
+ *
+ * 8 bytes   "WARNNUE1"
+ * int32     NUM_INPUTS, then HIDDEN, then the output shift
+ * int16     HIDDEN hidden biases
+ * int16     NUM_INPUTS x HIDDEN hidden weights, input by input
+ * int8      HIDDEN output weights
+ * int32     output bias when Player Blue is to move, then when Player Green is
+ *
+ * Input p * MAX_CELLS + cell is Player Blue's (p = 0) or Player Green's
+ * (p = 1) piece in cell. The correction is the output weights' dot product
+ * plus the output bias, shifted right by the output shift.
+ */
+class Network
+{
+	public:
+		static const int NUM_INPUTS = 2 * Layout::MAX_CELLS;
+		static const int HIDDEN = 32;
+
+		/**
+		 * This class holds the hidden neurons' sums for one position.
+		 */
+		class Accumulator
+		{
+			public:
+				int16_t sums[HIDDEN];
+		};
+
+		Network();
+		bool load(const char * filename);
+
+		void refresh(const Position & position, Accumulator & accumulator) const;
+		void update(const Accumulator & parent, const Move & move, char player,
+		            Accumulator & child) const;
+		int evaluate(const Accumulator & accumulator, char playerToMove) const;
+
+	private:
+		int16_t hiddenBiases[HIDDEN];
+		int16_t hiddenWeights[NUM_INPUTS][HIDDEN];
+		//the int8 output weights, widened to int16 for the dot product.
+		int16_t outputWeights[HIDDEN];
+		int32_t outputBiases[2];
+		int outputShift;
+};
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @file ponder.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "ponder.h"
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace std;
+
+/**
+ * Constructor of a Ponderer
+ * 
+ * @param player Char of the AI Player that ponders (the opponent is the other player).
+ * @param options Settings of the searches that the AI Player runs while pondering.
+ */
+Ponderer::Ponderer(char player, const Minimax::Options & options)
+	: options(options), stop(false)
+{
+	this->player = player;
+	//seeded from rand() here, so that srand() still decides the War Game.
+	this->randomState = rand();
+	this->board = NULL;
+	this->current = -1;
+	this->wanted = -1;
+	this->numHits = 0;
+	this->numTries = 0;
+}
+
+/**
+ * Stops the background thread and frees the pondered Board.
+ */
+Ponderer::~Ponderer()
+{
+	this->halt();
+}
+
+/**
+ * Starts pondering on a Board where the opponent is about to move.
+ * 
+ * @param currBoard Board where it is the opponent's turn
+ */
+void Ponderer::start(const Board * currBoard)
+{
+	this->halt();
+	this->board = new Board(currBoard);
+	this->replies.clear();
+	this->current = -1;
+	this->wanted = -1;
+	this->stop.store(false);
+
+	//find all of the opponent's legal replies and how much each one gains them.
+	char opponent = (player == Minimax::MAX) ? Minimax::MIN : Minimax::MAX;
+	int blue = 0; int green = 0;
+	board->updateScore(blue, green);
+	int before = (opponent == 'B') ? blue - green : green - blue;
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = 0; j < 6; j++)
+		{
+			Board * childBoard = new Board(board);
+			if (childBoard->putPiece(i, j, opponent) != 0)
+			{
+				childBoard->updateScore(blue, green);
+				int after = (opponent == 'B') ? blue - green : green - blue;
+				replies.push_back(Reply(i, j, after - before));
+			}
+			delete childBoard;
+		}
+	}
+	//the likeliest replies are searched first.
+	stable_sort(replies.begin(), replies.end(), isLikelier);
+
+	this->worker = thread(&Ponderer::run, this);
+}
+
+/**
+ * Stops pondering once the opponent's real reply is known.
+ * If the answer to that reply was already searched, it is returned instantly.
+ * If it is being searched right now, this waits for that search to finish.
+ * 
+ * @param oppRow Row of the opponent's real reply
+ * @param oppCol Col of the opponent's real reply
+ * @param row Int that will hold the row of the move to make.
+ * @param col Int that will hold the col of the move to make.
+ * @param numNodes Int that will hold the number of nodes the answer's search expanded.
+ * 
+ * @return True if the answer was found by pondering,
+ *         false if the AI Player must search for it as usual.
+ */
+bool Ponderer::finish(int oppRow, int oppCol, int & row, int & col, int & numNodes)
+{
+	bool hit = false;
+	{
+		unique_lock<mutex> guard(lock);
+		numTries++;
+		//find the opponent's real reply among the pondered ones.
+		int index = -1;
+		for (unsigned int i = 0; i < replies.size(); i++)
+		{
+			if (replies[i].oppRow == oppRow && replies[i].oppCol == oppCol)
+				index = i;
+		}
+		//if the real reply is being searched right now, let that search finish.
+		if (index >= 0 && index == current)
+		{
+			wanted = index;
+			while (replies[index].done == false && current == index)
+				changed.wait(guard);
+		}
+		if (index >= 0 && replies[index].done && replies[index].row >= 0)
+		{
+			hit = true;
+			row = replies[index].row;
+			col = replies[index].col;
+			numNodes = replies[index].numNodes;
+		}
+	}
+	this->halt();
+	if (hit) numHits++;
+	return hit;
+}
+
+/**
+ * Getter function
+ * 
+ * @return numHits Number of times the answer was found by pondering
+ */
+int Ponderer::getNumHits()
+{
+	return this->numHits;
+}
+
+/**
+ * Getter function
+ * 
+ * @return numTries Number of times pondering was finished
+ */
+int Ponderer::getNumTries()
+{
+	return this->numTries;
+}
+
+/**
+ * Constructor of a Reply
+ * 
+ * @param oppRow Row of the opponent's reply
+ * @param oppCol Col of the opponent's reply
+ * @param gain How much the reply gains the opponent right away
+ */
+Ponderer::Reply::Reply(int oppRow, int oppCol, int gain)
+{
+	this->oppRow = oppRow;
+	this->oppCol = oppCol;
+	this->gain = gain;
+	this->done = false;
+	this->row = -1;
+	this->col = -1;
+	this->numNodes = 0;
+}
+
+/**
+ * Body of the background thread. Searches the AI Player's answer
+ * to each of the opponent's replies, until it is stopped.
+ */
+void Ponderer::run()
+{
+	char opponent = (player == Minimax::MAX) ? Minimax::MIN : Minimax::MAX;
+	for (unsigned int i = 0; i < replies.size(); i++)
+	{
+		{
+			lock_guard<mutex> guard(lock);
+			//stop once told to, or once the wanted reply is no longer searched.
+			if (stop.load() || wanted >= 0)
+				break;
+			current = i;
+		}
+
+		Board * childBoard = new Board(board);
+		childBoard->putPiece(replies[i].oppRow, replies[i].oppCol, opponent);
+		int row = -1; int col = -1; int numNodes = 0;
+		bool searched = true;
+		//if the reply ends the game, there is no answer to search.
+		if (childBoard->isGameOver() == false)
+		{
+			Minimax::Options searchOptions = options;
+			searchOptions.stop = &stop;
+			searchOptions.randomState = &randomState;
+			Minimax * tree = new Minimax(player, childBoard, searchOptions);
+			searched = (tree->wasAborted() == false);
+			if (searched)
+				tree->chooseNextMove(row, col);
+			numNodes = tree->getNumNodes();
+			delete tree;
+		}
+		delete childBoard;
+
+		{
+			lock_guard<mutex> guard(lock);
+			if (searched)
+			{
+				replies[i].done = true;
+				replies[i].row = row;
+				replies[i].col = col;
+				replies[i].numNodes = numNodes;
+			}
+			current = -1;
+		}
+		changed.notify_all();
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		current = -1;
+	}
+	changed.notify_all();
+}
+
+/**
+ * Stops the background thread, if it runs, and frees the pondered Board.
+ */
+void Ponderer::halt()
+{
+	stop.store(true);
+	if (worker.joinable())
+		worker.join();
+	delete board;
+	board = NULL;
+}
+
+/**
+ * Orders replies so that the opponent's most greedy replies come first,
+ * since those are the replies the opponent most likely makes.
+ * 
+ * @param a First reply to compare
+ * @param b Second reply to compare
+ * 
+ * @return True if a should be searched before b
+ */
+bool Ponderer::isLikelier(const Reply & a, const Reply & b)
+{
+	return a.gain > b.gain;
+}
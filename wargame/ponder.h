@@ -0,0 +1,81 @@
+/**
+ * @file ponder.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef PONDER_H
+#define PONDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "board.h"
+#include "minimax.h"
+
+using namespace std;
+
+/**
+ * This class lets an AI Player think during its opponent's turn.
+ * While the opponent chooses a move, a background thread goes through
+ * the opponent's legal replies, most likely reply first, and searches
+ * the AI Player's answer to each of them. Once the real reply is known,
+ * the AI Player can answer instantly if that reply was already searched,
+ * or once its search finishes if it is being searched right now. Otherwise
+ * the pondering is dropped and the real search starts over, unless the
+ * searches share a PositionCache: then it finds the positions pondering
+ * stored there, even those of a search that was cut short. Pondering
+ * breaks ties with a random state of its own, since it runs alongside
+ * the other AI Player's search.
+ */
+class Ponderer
+{
+	public:
+		Ponderer(char player, const Minimax::Options & options);
+		~Ponderer();
+
+		void start(const Board * currBoard);
+		bool finish(int oppRow, int oppCol, int & row, int & col, int & numNodes);
+
+		int getNumHits();
+		int getNumTries();
+
+	private:
+		/**
+		 * Reply is one legal move of the opponent together with
+		 * the AI Player's answer to it, once that answer is searched.
+		 */
+		class Reply
+		{
+			public:
+				Reply(int oppRow, int oppCol, int gain);
+
+				int oppRow;
+				int oppCol;
+				int gain;
+				bool done;
+				int row;
+				int col;
+				int numNodes;
+		};
+
+		char player;
+		Minimax::Options options;
+		unsigned int randomState;
+		Board * board;
+		vector<Reply> replies;
+		int current;
+		int wanted;
+		atomic<bool> stop;
+		mutex lock;
+		condition_variable changed;
+		thread worker;
+		int numHits;
+		int numTries;
+
+		void run();
+		void halt();
+		static bool isLikelier(const Reply & a, const Reply & b);
+};
+
+#endif
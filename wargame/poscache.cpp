@@ -0,0 +1,281 @@
+/**
+ * @file poscache.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "poscache.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * Default Constructor
+ * A cache that is not backed by a file yet.
+ */
+PositionCache::PositionCache()
+{
+	this->fd = -1;
+	this->map = NULL;
+	this->mapSize = 0;
+	this->entries = NULL;
+	this->numBuckets = 0;
+	this->generation = 0;
+}
+
+/**
+ * Unmaps the file. Whatever was written to it stays there.
+ */
+PositionCache::~PositionCache()
+{
+	this->close();
+}
+
+/**
+ * Opens the cache file, creating it if it does not exist yet. A new file
+ * holds as many buckets as fit in maxBytes; an existing file keeps the
+ * size it was created with. Processes that open the file at the same
+ * time take turns, so that only one of them sets it up.
+ *
+ * @param filename Name of the cache file
+ * @param maxBytes Size of the file if it is created
+ *
+ * @return True if the file could be opened and mapped
+ */
+bool PositionCache::open(const char * filename, long long maxBytes)
+{
+	this->close();
+	fd = ::open(filename, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return false;
+	flock(fd, LOCK_EX);
+	struct stat info;
+	bool created = false;
+	if (fstat(fd, &info) != 0)
+	{
+		this->close();
+		return false;
+	}
+	//a new file is sized now, and its header is written once it is mapped.
+	if (info.st_size == 0)
+	{
+		long long bucketBytes = BUCKET_SIZE * sizeof(Entry);
+		long long buckets = (maxBytes - HEADER_SIZE) / bucketBytes;
+		if (buckets < 1)
+			buckets = 1;
+		info.st_size = HEADER_SIZE + buckets * bucketBytes;
+		if (ftruncate(fd, info.st_size) != 0)
+		{
+			this->close();
+			return false;
+		}
+		created = true;
+	}
+	mapSize = info.st_size;
+	map = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+	{
+		map = NULL;
+		this->close();
+		return false;
+	}
+	char * header = (char *)map;
+	uint64_t buckets = 0;
+	if (created)
+	{
+		buckets = (mapSize - HEADER_SIZE) / (BUCKET_SIZE * sizeof(Entry));
+		memcpy(header, "WARCACH1", 8);
+		memcpy(header + 8, &buckets, sizeof(buckets));
+	}
+	memcpy(&buckets, header + 8, sizeof(buckets));
+	//error handling for files that are not caches, or were cut short.
+	if (memcmp(header, "WARCACH1", 8) != 0 || buckets < 1
+	    || HEADER_SIZE + buckets * BUCKET_SIZE * sizeof(Entry) != mapSize)
+	{
+		this->close();
+		return false;
+	}
+	//this run's entries are told apart from the older ones by their generation.
+	uint32_t * runs = (uint32_t *)(header + 16);
+	generation = (unsigned char)(__atomic_add_fetch(runs, 1, __ATOMIC_RELAXED));
+	flock(fd, LOCK_UN);
+	numBuckets = buckets;
+	entries = (Entry *)(header + HEADER_SIZE);
+	return true;
+}
+
+/**
+ * Getter function
+ *
+ * @return True if a cache file is open
+ */
+bool PositionCache::isOpen()
+{
+	return this->entries != NULL;
+}
+
+/**
+ * Hashes what tells the Boards apart: their size and the values of their pieces.
+ *
+ * @param layout Layout of the Board
+ *
+ * @return unsigned long long The hash of the Layout
+ */
+unsigned long long PositionCache::layoutKey(const Layout & layout)
+{
+	unsigned long long key = mix(layout.size);
+	for (int cell = 0; cell < layout.numCells; cell++)
+		key = mix(key ^ (unsigned long long)layout.values[cell]);
+	return key;
+}
+
+/**
+ * Looks up a position. The entry found may have been searched to any depth.
+ *
+ * @param layoutKey Hash of the position's Layout
+ * @param position Position to look up
+ * @param player Player to move
+ * @param value Int that will hold the value of the position
+ * @param depth Int that will hold the number of plies that were searched
+ * @param bound Char that will hold EXACT, LOWER or UPPER
+ * @param bestCell Int that will hold the cell of the best move, or -1
+ *
+ * @return True if the position was found
+ */
+bool PositionCache::probe(unsigned long long layoutKey, const Position & position, char player,
+                          int & value, int & depth, char & bound, int & bestCell)
+{
+	if (entries == NULL)
+		return false;
+	unsigned long long key = positionKey(layoutKey, position, player);
+	Entry * bucket = entries + (key % numBuckets) * BUCKET_SIZE;
+	for (int i = 0; i < BUCKET_SIZE; i++)
+	{
+		uint64_t check = __atomic_load_n(&bucket[i].check, __ATOMIC_RELAXED);
+		uint64_t data = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+		//an entry that was torn by two writers, or holds another position, does not match.
+		if ((check ^ data) != key || ((data >> 40) & 255) == 0)
+			continue;
+		value = (int32_t)(uint32_t)data;
+		depth = (data >> 32) & 255;
+		bound = (data >> 40) & 255;
+		int cell = (data >> 48) & 255;
+		bestCell = (cell == 255) ? -1 : cell;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Saves the value of a searched position. An entry of the same position
+ * is only replaced by a search at least as deep.
+ *
+ * @param layoutKey Hash of the position's Layout
+ * @param position Position that was searched
+ * @param player Player to move
+ * @param value Value of the position
+ * @param depth Number of plies that were searched
+ * @param bound EXACT, LOWER or UPPER
+ * @param bestCell Cell of the best move, or -1
+ */
+void PositionCache::store(unsigned long long layoutKey, const Position & position, char player,
+                          int value, int depth, char bound, int bestCell)
+{
+	if (entries == NULL)
+		return;
+	unsigned long long key = positionKey(layoutKey, position, player);
+	Entry * bucket = entries + (key % numBuckets) * BUCKET_SIZE;
+	//pick the entry of this position if there is one, or else the least valuable entry.
+	int victim = 0;
+	int victimWorth = 0;
+	for (int i = 0; i < BUCKET_SIZE; i++)
+	{
+		uint64_t check = __atomic_load_n(&bucket[i].check, __ATOMIC_RELAXED);
+		uint64_t data = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+		int oldDepth = (data >> 32) & 255;
+		if ((check ^ data) == key && ((data >> 40) & 255) != 0)
+		{
+			if (depth < oldDepth)
+				return;
+			victim = i;
+			break;
+		}
+		int age = (unsigned char)(generation - (data >> 56));
+		int worth = (((data >> 40) & 255) == 0) ? -1000000 : oldDepth - AGE_WEIGHT * age;
+		if (i == 0 || worth < victimWorth)
+		{
+			victim = i;
+			victimWorth = worth;
+		}
+	}
+	if (depth > 255)
+		depth = 255;
+	uint64_t data = (uint64_t)(uint32_t)value
+	                | ((uint64_t)depth << 32)
+	                | ((uint64_t)(unsigned char)bound << 40)
+	                | ((uint64_t)(bestCell < 0 ? 255 : bestCell) << 48)
+	                | ((uint64_t)generation << 56);
+	__atomic_store_n(&bucket[victim].check, key ^ data, __ATOMIC_RELAXED);
+	__atomic_store_n(&bucket[victim].data, data, __ATOMIC_RELAXED);
+}
+
+/**
+ * Getter function
+ *
+ * @return long long Number of entries the file holds
+ */
+long long PositionCache::getNumEntries()
+{
+	return this->numBuckets * BUCKET_SIZE;
+}
+
+/**
+ * Hashes a position of a Board with the player to move.
+ *
+ * @param layoutKey Hash of the position's Layout
+ * @param position Position to hash
+ * @param player Player to move
+ *
+ * @return unsigned long long The key of the position's entry
+ */
+unsigned long long PositionCache::positionKey(unsigned long long layoutKey,
+                                              const Position & position, char player)
+{
+	unsigned long long key = mix(layoutKey ^ position.blue);
+	key = mix(key ^ position.green);
+	return mix(key ^ (player == 'G' ? 1 : 2));
+}
+
+/**
+ * Scrambles the bits of a number (the finalizer of SplitMix64).
+ *
+ * @param x Number to scramble
+ *
+ * @return unsigned long long The scrambled number
+ */
+unsigned long long PositionCache::mix(unsigned long long x)
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+/**
+ * Unmaps and closes the cache file, if one is open.
+ */
+void PositionCache::close()
+{
+	if (map != NULL)
+		munmap(map, mapSize);
+	if (fd >= 0)
+		::close(fd);
+	this->fd = -1;
+	this->map = NULL;
+	this->mapSize = 0;
+	this->entries = NULL;
+	this->numBuckets = 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file poscache.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef POSCACHE_H
+#define POSCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "position.h"
+
+/**
+ * This class is a cache of searched positions kept in a file, so that
+ * what one run of the AI found is still known to the next one. Each entry
+ * holds the value of a position searched some plies deep, whether that
+ * value is exact or only a bound, and the best move found there. Entries
+ * are keyed by a hash of the Layout together with the position and the
+ * player to move, so the five Boards share one file.
+ *
+ * The file is mapped into memory and shared by every process that opens
+ * it. Entries are read and written without locks: each one is stored as
+ * its data and its key XORed with its data, so an entry that two processes
+ * wrote at once no longer matches its key and is taken as a miss.
+ *
+ * The file never grows past the size it was created with. The entries are
+ * grouped into buckets of BUCKET_SIZE, and a new position replaces the
+ * entry of its bucket that was searched the least deep, counting each run
+ * since the entry was written as AGE_WEIGHT plies less.
+ *
+ * The file starts with a HEADER_SIZE-byte header: the 8 bytes "WARCACH1",
+ * the number of buckets (uint64) and the number of runs that opened the
+ * file (uint32). The buckets follow it.
+ */
+class PositionCache
+{
+	public:
+		//how the value in an entry relates to the position's value.
+		static const char EXACT = 1;
+		static const char LOWER = 2;
+		static const char UPPER = 3;
+
+		static const int BUCKET_SIZE = 4;
+		static const int AGE_WEIGHT = 2;
+		static const int HEADER_SIZE = 64;
+
+		PositionCache();
+		~PositionCache();
+		bool open(const char * filename, long long maxBytes);
+		bool isOpen();
+
+		static unsigned long long layoutKey(const Layout & layout);
+		bool probe(unsigned long long layoutKey, const Position & position, char player,
+		           int & value, int & depth, char & bound, int & bestCell);
+		void store(unsigned long long layoutKey, const Position & position, char player,
+		           int value, int depth, char bound, int bestCell);
+
+		long long getNumEntries();
+
+	private:
+		/**
+		 * This class is one entry as it is laid out in the file.
+		 */
+		class Entry
+		{
+			public:
+				//the key XORed with the data.
+				uint64_t check;
+				//the value, then the depth, bound, best cell and run, a byte each.
+				uint64_t data;
+		};
+
+		int fd;
+		void * map;
+		size_t mapSize;
+		Entry * entries;
+		unsigned long long numBuckets;
+		//run that opened the file this time.
+		unsigned char generation;
+
+		static unsigned long long positionKey(unsigned long long layoutKey,
+		                                      const Position & position, char player);
+		static unsigned long long mix(unsigned long long x);
+		void close();
+};
+
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file position.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "position.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Constructs the Layout of a 6x6 Board.
+ * 
+ * @param board Board whose piece values are copied
+ */
+Layout::Layout(const Board * board)
+{
+	int boardValues[MAX_CELLS];
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = 0; j < 6; j++)
+		{
+			boardValues[i * 6 + j] = board->getValue(i, j);
+		}
+	}
+	this->setUp(6, boardValues);
+}
+
+/**
+ * Constructs the Layout of a square board of any size up to 6x6.
+ * 
+ * @param size Number of rows (and columns) of the board
+ * @param values Values of the pieces, row by row
+ */
+Layout::Layout(int size, const int * values)
+{
+	this->setUp(size, values);
+}
+
+/**
+ * Helper function for the constructors which copies the values
+ * and finds the neighbors of each cell.
+ * 
+ * @param size Number of rows (and columns) of the board
+ * @param values Values of the pieces, row by row
+ */
+void Layout::setUp(int size, const int * values)
+{
+	this->size = size;
+	this->numCells = size * size;
+	this->allCells = (numCells == 64) ? ~0ULL : (1ULL << numCells) - 1;
+	for (int cell = 0; cell < MAX_CELLS; cell++)
+	{
+		this->values[cell] = (cell < numCells) ? values[cell] : 0;
+		this->neighbors[cell] = 0;
+		this->hasWest[cell] = 0;
+		this->hasEast[cell] = 0;
+		this->swing[cell] = 0;
+	}
+	for (int row = 0; row < size; row++)
+	{
+		for (int col = 0; col < size; col++)
+		{
+			unsigned long long mask = 0;
+			if (row - 1 >= 0) mask |= 1ULL << ((row - 1) * size + col);
+			if (row + 1 < size) mask |= 1ULL << ((row + 1) * size + col);
+			if (col - 1 >= 0) mask |= 1ULL << (row * size + col - 1);
+			if (col + 1 < size) mask |= 1ULL << (row * size + col + 1);
+			this->neighbors[row * size + col] = mask;
+			this->hasWest[row * size + col] = (col - 1 >= 0);
+			this->hasEast[row * size + col] = (col + 1 < size);
+		}
+	}
+	for (int cell = 0; cell < numCells; cell++)
+	{
+		this->swing[cell] = this->values[cell];
+		for (int other = 0; other < numCells; other++)
+		{
+			if ((neighbors[cell] >> other) & 1)
+				this->swing[cell] += 2 * this->values[other];
+		}
+	}
+}
+
+/**
+ * Default Constructor
+ * A position where no player controls any piece.
+ */
+Position::Position()
+{
+	this->blue = 0;
+	this->green = 0;
+}
+
+/**
+ * Constructs the position of a 6x6 Board.
+ * 
+ * @param board Board whose controlling players are copied
+ */
+Position::Position(const Board * board)
+{
+	this->blue = 0;
+	this->green = 0;
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = 0; j < 6; j++)
+		{
+			if (board->getPlayer(i, j) == 'B')
+				this->blue |= 1ULL << (i * 6 + j);
+			else if (board->getPlayer(i, j) == 'G')
+				this->green |= 1ULL << (i * 6 + j);
+		}
+	}
+}
+
+/**
+ * Tests if the game is finished, which is when no piece is empty.
+ * 
+ * @param layout Layout of the board
+ * 
+ * @return boolean
+ */
+bool Position::isGameOver(const Layout & layout) const
+{
+	return emptyCells(layout) == 0;
+}
+
+/**
+ * Finds Player Blue's score minus Player Green's score.
+ * 
+ * @param layout Layout of the board
+ * 
+ * @return int
+ */
+int Position::scoreDiff(const Layout & layout) const
+{
+	int diff = 0;
+	for (int cell = 0; cell < layout.numCells; cell++)
+	{
+		if ((blue >> cell) & 1)
+			diff += layout.values[cell];
+		else if ((green >> cell) & 1)
+			diff -= layout.values[cell];
+	}
+	return diff;
+}
+
+/**
+ * Finds the pieces that no player controls yet.
+ * 
+ * @param layout Layout of the board
+ * 
+ * @return unsigned long long Bit mask of the empty cells
+ */
+unsigned long long Position::emptyCells(const Layout & layout) const
+{
+	return layout.allCells & ~(blue | green);
+}
+
+/**
+ * Player takes the piece in cell, just like Board::putPiece.
+ * 
+ * @param layout Layout of the board
+ * @param cell Cell of the piece to take
+ * @param player Character representing player that takes the piece
+ * 
+ * @return int 0 - move is illegal
+ *             1 - move is legal and is a para drop
+ *             2 - move is legal and is a blitz
+ */
+int Position::putPiece(const Layout & layout, int cell, char player)
+{
+	//do a boundary check on cell, and check if the piece was already taken.
+	if (cell < 0 || cell >= layout.numCells || ((emptyCells(layout) >> cell) & 1) == 0)
+		return 0;
+	unsigned long long & mine = (player == 'B') ? blue : green;
+	unsigned long long & theirs = (player == 'B') ? green : blue;
+	//para drop.
+	mine |= 1ULL << cell;
+	//death blitz, if player owns a piece adjacent to the piece they took.
+	if ((layout.neighbors[cell] & mine) == 0)
+		return 1;
+	unsigned long long flipped = layout.neighbors[cell] & theirs;
+	theirs &= ~flipped;
+	mine |= flipped;
+	return 2;
+}
+
+/**
+ * Finds all of player's legal moves in one pass over the board,
+ * without making any of them. For every cell at once, it finds out
+ * whether player owns a neighbor (so the move is a Death Blitz) and
+ * the total value of the opponent's neighbors (which a Death Blitz
+ * flips), by adding up shifted copies of the board's values.
+ * 
+ * @param layout Layout of the board
+ * @param player Character representing player to move
+ * @param moves Array of at least Layout::MAX_CELLS moves to fill in
+ * 
+ * @return int Number of legal moves, in the order of their cells
+ */
+int Position::generateMoves(const Layout & layout, char player, Move * moves) const
+{
+	//the rows before and after the board are padding, so that
+	//the neighbors of every cell can be read without bound checks.
+	const int PAD = Layout::MAX_SIZE;
+	int ownCount[Layout::MAX_CELLS + 2 * PAD];
+	int oppValue[Layout::MAX_CELLS + 2 * PAD];
+	int ownNeighbors[Layout::MAX_CELLS];
+	int oppNeighborValue[Layout::MAX_CELLS];
+	unsigned long long mine = (player == 'B') ? blue : green;
+	unsigned long long theirs = (player == 'B') ? green : blue;
+	int numCells = layout.numCells;
+	int size = layout.size;
+
+	for (int i = 0; i < numCells + 2 * PAD; i++)
+	{
+		ownCount[i] = 0;
+		oppValue[i] = 0;
+	}
+	for (int cell = 0; cell < numCells; cell++)
+	{
+		ownCount[PAD + cell] = (mine >> cell) & 1;
+		oppValue[PAD + cell] = ((theirs >> cell) & 1) * layout.values[cell];
+	}
+	//sum each cell's north, south, west and east neighbors for all cells at once.
+	for (int cell = 0; cell < numCells; cell++)
+	{
+		ownNeighbors[cell] = ownCount[PAD + cell - size] + ownCount[PAD + cell + size]
+		                   + layout.hasWest[cell] * ownCount[PAD + cell - 1]
+		                   + layout.hasEast[cell] * ownCount[PAD + cell + 1];
+		oppNeighborValue[cell] = oppValue[PAD + cell - size] + oppValue[PAD + cell + size]
+		                       + layout.hasWest[cell] * oppValue[PAD + cell - 1]
+		                       + layout.hasEast[cell] * oppValue[PAD + cell + 1];
+	}
+
+	//every empty cell is a legal move.
+	int numMoves = 0;
+	unsigned long long empty = emptyCells(layout);
+	while (empty != 0)
+	{
+		int cell = __builtin_ctzll(empty);
+		empty &= empty - 1;
+		Move & move = moves[numMoves++];
+		move.cell = cell;
+		move.blitz = (ownNeighbors[cell] > 0);
+		move.flipped = move.blitz ? (layout.neighbors[cell] & theirs) : 0;
+		//a flipped piece is lost by the opponent and won by the player.
+		move.delta = layout.values[cell] + (move.blitz ? 2 * oppNeighborValue[cell] : 0);
+	}
+	return numMoves;
+}
+
+/**
+ * Makes a move found by generateMoves.
+ * 
+ * @param move Move to make
+ * @param player Character representing player that makes the move
+ */
+void Position::makeMove(const Move & move, char player)
+{
+	unsigned long long & mine = (player == 'B') ? blue : green;
+	unsigned long long & theirs = (player == 'B') ? green : blue;
+	mine |= (1ULL << move.cell) | move.flipped;
+	theirs &= ~move.flipped;
+}
+
+/**
+ * Compares moves so that blitzes come first, then moves that gain more.
+ * 
+ * @param a First move to compare
+ * @param b Second move to compare
+ * 
+ * @return True if a should be searched before b
+ */
+static bool isBetterMove(const Move & a, const Move & b)
+{
+	if (a.blitz != b.blitz)
+		return a.blitz;
+	return a.delta > b.delta;
+}
+
+/**
+ * Orders moves so that the most promising moves are searched first,
+ * which lets alpha-beta pruning cut off sooner.
+ * 
+ * @param moves Moves to order
+ * @param numMoves Number of moves
+ */
+void Position::orderMoves(Move * moves, int numMoves)
+{
+	stable_sort(moves, moves + numMoves, isBetterMove);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file position.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "board.h"
+
+/**
+ * This class holds what does not change during a War Game:
+ * the size of the board, the value of each piece, and which
+ * pieces neighbor each other. Pieces are numbered row by row,
+ * so the piece in (row, col) is cell row * size + col.
+ */
+class Layout
+{
+	public:
+		static const int MAX_SIZE = 6;
+		static const int MAX_CELLS = MAX_SIZE * MAX_SIZE;
+
+		Layout(const Board * board);
+		Layout(int size, const int * values);
+
+		int size;
+		int numCells;
+		//bit mask with one bit set for each cell of the board.
+		unsigned long long allCells;
+		int values[MAX_CELLS];
+		//bit mask of the north, south, west and east neighbors of each cell.
+		unsigned long long neighbors[MAX_CELLS];
+		//1 if a cell has a west (or east) neighbor, 0 if not.
+		int hasWest[MAX_CELLS];
+		int hasEast[MAX_CELLS];
+		//most that taking a cell can ever change a player's score minus
+		//the opponent's: its value plus twice its neighbors' values.
+		int swing[MAX_CELLS];
+
+	private:
+		void setUp(int size, const int * values);
+};
+
+/**
+ * This class is one legal move: the cell a player takes, whether it is
+ * a Death Blitz, which of the opponent's pieces it flips, and how much
+ * it changes the player's score minus the opponent's score.
+ */
+class Move
+{
+	public:
+		int cell;
+		bool blitz;
+		unsigned long long flipped;
+		int delta;
+};
+
+/**
+ * This class is a compact War Game board state. Instead of a BoardPiece
+ * per piece, it keeps one bit mask of the pieces each player controls,
+ * and it needs a Layout to know the values of the pieces.
+ */
+class Position
+{
+	public:
+		Position();
+		Position(const Board * board);
+
+		bool isGameOver(const Layout & layout) const;
+		int scoreDiff(const Layout & layout) const;
+		unsigned long long emptyCells(const Layout & layout) const;
+		int putPiece(const Layout & layout, int cell, char player);
+		int generateMoves(const Layout & layout, char player, Move * moves) const;
+		void makeMove(const Move & move, char player);
+		static void orderMoves(Move * moves, int numMoves);
+
+		//pieces controlled by Player Blue and Player Green.
+		unsigned long long blue;
+		unsigned long long green;
+};
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file searchstats.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "searchstats.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+#ifdef WARGAME_STATS
+const bool SearchStats::ENABLED = true;
+#else
+const bool SearchStats::ENABLED = false;
+#endif
+
+/**
+ * Default Constructor
+ * Starts with all statistics at 0.
+ */
+SearchStats::SearchStats()
+{
+	this->reset();
+}
+
+/**
+ * Sets all statistics back to 0.
+ */
+void SearchStats::reset()
+{
+	for (int i = 0; i < MAX_PLY; i++)
+		nodesPerPly[i] = 0;
+	maxPly = 0;
+	interiorNodes = 0;
+	leafEvals = 0;
+	terminalNodes = 0;
+	betaCutoffs = 0;
+	firstMoveCutoffs = 0;
+	boundCutoffs = 0;
+	reductions = 0;
+	researches = 0;
+	quiescenceNodes = 0;
+	deltaPrunes = 0;
+	hashHits = 0;
+	hashMisses = 0;
+	iterationTimes.clear();
+	nodesUsed = 0;
+	nodeBudget = 0;
+	peakBytes = 0;
+	byteBudget = 0;
+	budgetHit = false;
+}
+
+/**
+ * Adds the statistics of another search, such as the next iteration of
+ * an iterative deepening search. Counts are added up, while the most
+ * bytes used is the most of either search.
+ * 
+ * @param other Statistics to add
+ */
+void SearchStats::add(const SearchStats & other)
+{
+	for (int i = 0; i < MAX_PLY; i++)
+		nodesPerPly[i] += other.nodesPerPly[i];
+	maxPly = max(maxPly, other.maxPly);
+	interiorNodes += other.interiorNodes;
+	leafEvals += other.leafEvals;
+	terminalNodes += other.terminalNodes;
+	betaCutoffs += other.betaCutoffs;
+	firstMoveCutoffs += other.firstMoveCutoffs;
+	boundCutoffs += other.boundCutoffs;
+	reductions += other.reductions;
+	researches += other.researches;
+	quiescenceNodes += other.quiescenceNodes;
+	deltaPrunes += other.deltaPrunes;
+	hashHits += other.hashHits;
+	hashMisses += other.hashMisses;
+	iterationTimes.insert(iterationTimes.end(), other.iterationTimes.begin(), other.iterationTimes.end());
+	nodesUsed += other.nodesUsed;
+	peakBytes = max(peakBytes, other.peakBytes);
+	budgetHit = budgetHit || other.budgetHit;
+}
+
+/**
+ * Fraction of the cutoffs that happened on the first child searched.
+ * The closer to 1, the better the move ordering.
+ * 
+ * @return double between 0 and 1
+ */
+double SearchStats::firstMoveCutoffRate() const
+{
+	if (betaCutoffs == 0)
+		return 0;
+	return double(firstMoveCutoffs) / betaCutoffs;
+}
+
+/**
+ * Effective branching factor, the number of children per node that
+ * a uniform tree of the same depth would need to visit as many nodes
+ * at its deepest ply.
+ * 
+ * @return double, 0 if the search never went below the root
+ */
+double SearchStats::effectiveBranchingFactor() const
+{
+	if (maxPly == 0 || nodesPerPly[0] == 0)
+		return 0;
+	return pow(double(nodesPerPly[maxPly]) / nodesPerPly[0], 1.0 / maxPly);
+}
+
+/**
+ * Total number of nodes visited over all plies.
+ * 
+ * @return long long
+ */
+long long SearchStats::totalNodes() const
+{
+	long long total = 0;
+	for (int i = 0; i <= maxPly; i++)
+		total += nodesPerPly[i];
+	return total;
+}
+
+/**
+ * Writes the statistics as one line of JSON.
+ * 
+ * @param out Stream to write to
+ * @param moveNumber Number of the move in the game, starting at 1
+ * @param player Char of the player that searched
+ */
+void SearchStats::writeJson(ostream & out, int moveNumber, char player) const
+{
+	out << "{\"move\":" << moveNumber
+	    << ",\"player\":\"" << player << "\""
+	    << ",\"nodes\":" << totalNodes()
+	    << ",\"nodesPerPly\":[";
+	for (int i = 0; i <= maxPly; i++)
+		out << (i > 0 ? "," : "") << nodesPerPly[i];
+	out << "],\"interiorNodes\":" << interiorNodes
+	    << ",\"leafEvals\":" << leafEvals
+	    << ",\"terminalNodes\":" << terminalNodes
+	    << ",\"betaCutoffs\":" << betaCutoffs
+	    << ",\"firstMoveCutoffRate\":" << firstMoveCutoffRate()
+	    << ",\"boundCutoffs\":" << boundCutoffs
+	    << ",\"reductions\":" << reductions
+	    << ",\"researches\":" << researches
+	    << ",\"quiescenceNodes\":" << quiescenceNodes
+	    << ",\"deltaPrunes\":" << deltaPrunes
+	    << ",\"effectiveBranchingFactor\":" << effectiveBranchingFactor()
+	    << ",\"hashHits\":" << hashHits
+	    << ",\"hashMisses\":" << hashMisses
+	    << ",\"iterationTimes\":[";
+	for (unsigned int i = 0; i < iterationTimes.size(); i++)
+		out << (i > 0 ? "," : "") << iterationTimes[i];
+	out << "],\"nodesUsed\":" << nodesUsed
+	    << ",\"nodeBudget\":" << nodeBudget
+	    << ",\"peakBytes\":" << peakBytes
+	    << ",\"byteBudget\":" << byteBudget
+	    << ",\"budgetHit\":" << (budgetHit ? "true" : "false") << "}" << endl;
+}
+
+/**
+ * Writes the header row that matches writeCsv.
+ * 
+ * @param out Stream to write to
+ */
+void SearchStats::writeCsvHeader(ostream & out)
+{
+	out << "move,player,nodes,maxPly,interiorNodes,leafEvals,terminalNodes,"
+	    << "betaCutoffs,firstMoveCutoffRate,effectiveBranchingFactor,"
+	    << "boundCutoffs,reductions,researches,quiescenceNodes,deltaPrunes,"
+	    << "hashHits,hashMisses,iterations,seconds,"
+	    << "nodesUsed,nodeBudget,peakBytes,byteBudget,budgetHit,nodesPerPly" << endl;
+}
+
+/**
+ * Writes the statistics as one row of CSV. The nodes per ply
+ * are joined with ';' in the last column.
+ * 
+ * @param out Stream to write to
+ * @param moveNumber Number of the move in the game, starting at 1
+ * @param player Char of the player that searched
+ */
+void SearchStats::writeCsv(ostream & out, int moveNumber, char player) const
+{
+	double seconds = 0;
+	for (unsigned int i = 0; i < iterationTimes.size(); i++)
+		seconds += iterationTimes[i];
+	out << moveNumber << "," << player << "," << totalNodes() << "," << maxPly
+	    << "," << interiorNodes << "," << leafEvals << "," << terminalNodes
+	    << "," << betaCutoffs << "," << firstMoveCutoffRate()
+	    << "," << effectiveBranchingFactor()
+	    << "," << boundCutoffs << "," << reductions << "," << researches
+	    << "," << quiescenceNodes << "," << deltaPrunes
+	    << "," << hashHits << "," << hashMisses
+	    << "," << iterationTimes.size() << "," << seconds
+	    << "," << nodesUsed << "," << nodeBudget << "," << peakBytes
+	    << "," << byteBudget << "," << (budgetHit ? 1 : 0) << ",";
+	for (int i = 0; i <= maxPly; i++)
+		out << (i > 0 ? ";" : "") << nodesPerPly[i];
+	out << endl;
+}
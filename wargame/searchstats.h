@@ -0,0 +1,87 @@
+/**
+ * @file searchstats.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * STATS(statement) runs statement only when the search statistics
+ * are compiled in (build with "make STATS=1"), so counting costs
+ * nothing in a normal build.
+ */
+#ifdef WARGAME_STATS
+#define STATS(statement) statement
+#else
+#define STATS(statement)
+#endif
+
+/**
+ * This class holds the statistics of one Minimax search:
+ * how many nodes were visited at each ply, how many of them were
+ * leaves, how often alpha-beta pruning cut off and how early,
+ * how often caches were hit, and how long each iteration took.
+ * It can write itself out as one JSON line or one CSV row per move.
+ */
+class SearchStats
+{
+	public:
+		static const int MAX_PLY = 64;
+		//true if the search statistics are compiled in.
+		static const bool ENABLED;
+
+		SearchStats();
+		void reset();
+		void add(const SearchStats & other);
+
+		double firstMoveCutoffRate() const;
+		double effectiveBranchingFactor() const;
+		long long totalNodes() const;
+
+		void writeJson(ostream & out, int moveNumber, char player) const;
+		static void writeCsvHeader(ostream & out);
+		void writeCsv(ostream & out, int moveNumber, char player) const;
+
+		//number of nodes visited at each ply, the root being ply 0.
+		long long nodesPerPly[MAX_PLY];
+		//deepest ply that was visited.
+		int maxPly;
+		//nodes whose children were searched.
+		long long interiorNodes;
+		//nodes evaluated by the heuristic at the maximum depth.
+		long long leafEvals;
+		//nodes whose game was over.
+		long long terminalNodes;
+		//nodes whose search stopped early because of alpha-beta pruning.
+		long long betaCutoffs;
+		//cutoffs that happened on the first child searched.
+		long long firstMoveCutoffs;
+		//nodes cut off because no score swing could reach the window.
+		long long boundCutoffs;
+		//children searched one ply shallower, and those searched again.
+		long long reductions;
+		long long researches;
+		//positions searched past the maximum depth, and blitzes skipped there.
+		long long quiescenceNodes;
+		long long deltaPrunes;
+		//cache lookups that found and did not find a usable entry.
+		long long hashHits;
+		long long hashMisses;
+		//wall-clock seconds of each iteration of the search.
+		vector<double> iterationTimes;
+		//these are kept even when the statistics are not compiled in:
+		//the nodes and most bytes the search used, its budgets (0 if
+		//it had none), and whether it stopped because of a budget.
+		long long nodesUsed;
+		long long nodeBudget;
+		long long peakBytes;
+		long long byteBudget;
+		bool budgetHit;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file selfplay.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "selfplay.h"
+#include <sstream>
+#include "board.h"
+#include "deepening.h"
+#include "timing.h"
+
+using namespace std;
+
+/**
+ * Default Constructor
+ * A record of a War Game that has not been played yet.
+ */
+SelfPlay::GameRecord::GameRecord()
+{
+	this->boardNum = 0;
+	this->blueScore = 0;
+	this->greenScore = 0;
+	this->nodesBlue = 0;
+	this->nodesGreen = 0;
+	this->secondsBlue = 0;
+	this->secondsGreen = 0;
+}
+
+/**
+ * Plays one War Game between two AI Players until it is over.
+ * Ties between equally good moves are broken with rand(), unless the
+ * settings have a random state of their own, so seed it with srand()
+ * first to replay the same War Game.
+ * 
+ * @param boardNum A number representing which Board to play on (1 to 5).
+ * @param blueOptions Search settings of Player Blue, who moves first
+ * @param greenOptions Search settings of Player Green
+ * 
+ * @return GameRecord The outcome of the War Game
+ */
+SelfPlay::GameRecord SelfPlay::playGame(int boardNum, const Minimax::Options & blueOptions,
+                                        const Minimax::Options & greenOptions)
+{
+	GameRecord record;
+	record.boardNum = boardNum;
+	ostringstream moves;
+	Board * game = new Board(boardNum);
+	char currPlayer = 'B';
+	while (game->isGameOver() == false)
+	{
+		Stopwatch begin;
+		const Minimax::Options & options = (currPlayer == 'B') ? blueOptions : greenOptions;
+		int row = 0; int col = 0;
+		int numNodes = 0;
+		//with a budget, the move of the deepest search that fit in it is made.
+		if (options.maxNodes > 0 || options.maxBytes > 0)
+		{
+			DeepeningSearch search(currPlayer, game, options);
+			search.chooseNextMove(row, col);
+			numNodes = search.getNumNodes();
+		}
+		else
+		{
+			Minimax * tree = new Minimax(currPlayer, game, options);
+			tree->chooseNextMove(row, col);
+			numNodes = tree->getNumNodes();
+			delete tree;
+		}
+		game->putPiece(row, col, currPlayer);
+		Stopwatch end;
+		if (currPlayer == 'B')
+		{
+			record.nodesBlue += numNodes;
+			record.secondsBlue += end.secondsSince(begin);
+		}
+		else
+		{
+			record.nodesGreen += numNodes;
+			record.secondsGreen += end.secondsSince(begin);
+		}
+		moves << (moves.tellp() > 0 ? " " : "") << row << "," << col;
+		currPlayer = (currPlayer == 'B') ? 'G' : 'B';
+	}
+	game->updateScore(record.blueScore, record.greenScore);
+	record.moves = moves.str();
+	delete game;
+	return record;
+}
+
+/**
+ * Plays one War Game between two AI Players until it is over, breaking
+ * ties between equally good moves with the game's own random numbers.
+ * The same seed replays the same War Game, and War Games can be played
+ * on several threads at once.
+ * 
+ * @param boardNum A number representing which Board to play on (1 to 5).
+ * @param blueOptions Search settings of Player Blue, who moves first
+ * @param greenOptions Search settings of Player Green
+ * @param seed Seed of the War Game's random numbers
+ * 
+ * @return GameRecord The outcome of the War Game
+ */
+SelfPlay::GameRecord SelfPlay::playGame(int boardNum, const Minimax::Options & blueOptions,
+                                        const Minimax::Options & greenOptions, unsigned int seed)
+{
+	unsigned int randomState = seed;
+	Minimax::Options blue = blueOptions;
+	Minimax::Options green = greenOptions;
+	blue.randomState = &randomState;
+	green.randomState = &randomState;
+	return playGame(boardNum, blue, green);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file selfplay.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <string>
+#include "minimax.h"
+
+using namespace std;
+
+/**
+ * This class plays whole War Games between two AI Players without
+ * any input or output, so that AI settings can be compared.
+ */
+class SelfPlay
+{
+	public:
+		/**
+		 * GameRecord is the outcome of one War Game: the final scores,
+		 * the work each AI Player did, and every move that was made.
+		 */
+		class GameRecord
+		{
+			public:
+				GameRecord();
+
+				int boardNum;
+				int blueScore;
+				int greenScore;
+				long long nodesBlue;
+				long long nodesGreen;
+				double secondsBlue;
+				double secondsGreen;
+				//every move as "row,col", separated by spaces.
+				string moves;
+		};
+
+		static GameRecord playGame(int boardNum, const Minimax::Options & blueOptions,
+		                           const Minimax::Options & greenOptions);
+		static GameRecord playGame(int boardNum, const Minimax::Options & blueOptions,
+		                           const Minimax::Options & greenOptions, unsigned int seed);
+};
+
+#endif
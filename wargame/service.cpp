@@ -0,0 +1,400 @@
+/**
+ * @file service.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "service.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "deepening.h"
+#include "minimax.h"
+
+using namespace std;
+
+/**
+ * Constructor of an AnalysisService. Nothing is served until run() is called.
+ *
+ * @param socketPath Path of the Unix domain socket to listen on
+ * @param numWorkers Number of worker threads that run searches
+ * @param maxDepth Deepest search to run for a request
+ * @param maxBudgetMs Largest time budget a request can get, in milliseconds
+ */
+AnalysisService::AnalysisService(const char * socketPath, int numWorkers, int maxDepth, int maxBudgetMs)
+	: stopping(false)
+{
+	this->socketPath = socketPath;
+	this->numWorkers = numWorkers;
+	this->maxDepth = maxDepth;
+	this->maxBudgetMs = maxBudgetMs;
+	//the five Boards are loaded once and copied for each request.
+	for (int i = 0; i < 5; i++)
+		boards[i] = new Board(i + 1);
+	wakeFds[0] = -1;
+	wakeFds[1] = -1;
+	if (pipe(wakeFds) != 0)
+		wakeFds[0] = wakeFds[1] = -1;
+}
+
+/**
+ * Frees the Boards and closes the wake-up pipe.
+ */
+AnalysisService::~AnalysisService()
+{
+	for (int i = 0; i < 5; i++)
+		delete boards[i];
+	if (wakeFds[0] >= 0) close(wakeFds[0]);
+	if (wakeFds[1] >= 0) close(wakeFds[1]);
+}
+
+/**
+ * Serves requests until stop() is called. This thread reads requests and
+ * sends answers for every client, while the worker threads search.
+ *
+ * @return False if the socket could not be set up
+ */
+bool AnalysisService::run()
+{
+	if (wakeFds[0] < 0)
+		return false;
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+	unlink(socketPath.c_str());
+	if (listener < 0 || bind(listener, (struct sockaddr *)&address, sizeof(address)) != 0
+	    || listen(listener, 64) != 0)
+	{
+		if (listener >= 0) close(listener);
+		return false;
+	}
+	for (int i = 0; i < numWorkers; i++)
+		workers.push_back(thread(&AnalysisService::work, this));
+
+	//each client is known by an id rather than its socket, so that an answer
+	//for a client that left never goes to a new client on the same socket.
+	//clients never block this thread: answers wait in a client's output
+	//until its socket can take them.
+	map<int, int> clientFds;
+	map<int, string> clientInput;
+	map<int, string> clientOutput;
+	int nextClient = 0;
+	while (stopping.load() == false)
+	{
+		vector<struct pollfd> fds;
+		vector<int> fdClients;
+		struct pollfd entry;
+		entry.events = POLLIN;
+		entry.revents = 0;
+		entry.fd = wakeFds[0];
+		fds.push_back(entry);
+		entry.fd = listener;
+		fds.push_back(entry);
+		for (map<int, int>::iterator it = clientFds.begin(); it != clientFds.end(); ++it)
+		{
+			entry.fd = it->second;
+			entry.events = POLLIN | (clientOutput[it->first].empty() ? 0 : POLLOUT);
+			fds.push_back(entry);
+			fdClients.push_back(it->first);
+		}
+		if (poll(&fds[0], fds.size(), -1) < 0)
+			continue;
+
+		vector<pair<int, string> > toSend;
+		set<int> leaving;
+		//a new client connected.
+		if (fds[1].revents & POLLIN)
+		{
+			int fd = accept(listener, NULL, NULL);
+			if (fd >= 0)
+			{
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+				clientFds[nextClient++] = fd;
+			}
+		}
+		//a client sent requests, or left.
+		for (unsigned int i = 2; i < fds.size(); i++)
+		{
+			if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+				continue;
+			int client = fdClients[i - 2];
+			char buffer[4096];
+			ssize_t numRead = read(fds[i].fd, buffer, sizeof(buffer));
+			if (numRead == 0 || (numRead < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+			{
+				leaving.insert(client);
+				continue;
+			}
+			if (numRead > 0)
+				clientInput[client].append(buffer, numRead);
+			size_t newline;
+			while ((newline = clientInput[client].find('\n')) != string::npos)
+			{
+				string line = clientInput[client].substr(0, newline);
+				clientInput[client].erase(0, newline + 1);
+				if (line.size() > 0 && line[line.size() - 1] == '\r')
+					line.erase(line.size() - 1);
+				if (line == "QUIT")
+				{
+					leaving.insert(client);
+					break;
+				}
+				string answer = this->handleLine(client, line);
+				if (answer.size() > 0)
+					toSend.push_back(make_pair(client, answer));
+			}
+			//a request is far shorter than this, so a client that sends
+			//this much without a newline is hung up on.
+			if (clientInput[client].size() > MAX_INPUT_BYTES)
+				leaving.insert(client);
+		}
+		//workers finished searches. the pipe only wakes this thread up,
+		//so the answers are taken even if reading from it fails.
+		if (fds[0].revents & POLLIN)
+		{
+			char buffer[256];
+			ssize_t numWakeups = read(wakeFds[0], buffer, sizeof(buffer));
+			(void)numWakeups;
+		}
+		{
+			lock_guard<mutex> guard(lock);
+			while (answers.empty() == false)
+			{
+				toSend.push_back(answers.front());
+				answers.pop_front();
+			}
+		}
+		//queue the answers for the clients that are still connected.
+		for (unsigned int i = 0; i < toSend.size(); i++)
+		{
+			if (clientFds.count(toSend[i].first) > 0 && leaving.count(toSend[i].first) == 0)
+				clientOutput[toSend[i].first] += toSend[i].second + "\n";
+		}
+		//send as much of each client's output as its socket takes right now.
+		for (map<int, int>::iterator it = clientFds.begin(); it != clientFds.end(); ++it)
+		{
+			string & output = clientOutput[it->first];
+			while (output.empty() == false && leaving.count(it->first) == 0)
+			{
+				ssize_t numWritten = write(it->second, output.c_str(), output.size());
+				if (numWritten > 0)
+					output.erase(0, numWritten);
+				else if (numWritten < 0 && errno == EINTR)
+					continue;
+				else
+				{
+					if (numWritten == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+						leaving.insert(it->first);
+					break;
+				}
+			}
+		}
+		//nobody is left to answer, so the jobs a client still has queued are dropped.
+		for (set<int>::iterator it = leaving.begin(); it != leaving.end(); ++it)
+		{
+			this->dropClient(*it);
+			close(clientFds[*it]);
+			clientFds.erase(*it);
+			clientInput.erase(*it);
+			clientOutput.erase(*it);
+		}
+	}
+
+	//stop the workers, then hang up on every client.
+	{
+		lock_guard<mutex> guard(lock);
+		jobReady.notify_all();
+	}
+	for (unsigned int i = 0; i < workers.size(); i++)
+		workers[i].join();
+	workers.clear();
+	for (map<int, int>::iterator it = clientFds.begin(); it != clientFds.end(); ++it)
+		close(it->second);
+	close(listener);
+	unlink(socketPath.c_str());
+	return true;
+}
+
+/**
+ * Makes run() return. Searches that are running stop early.
+ * This only sets a flag and writes to a pipe, so it can be
+ * called from a signal handler.
+ */
+void AnalysisService::stop()
+{
+	stopping.store(true);
+	char wake = 0;
+	if (write(wakeFds[1], &wake, 1) < 0)
+		return;
+}
+
+/**
+ * Body of a worker thread. Takes the job of the game whose turn it is,
+ * searches it, and then lets the next game have its turn.
+ */
+void AnalysisService::work()
+{
+	while (true)
+	{
+		Job job;
+		{
+			unique_lock<mutex> guard(lock);
+			while (stopping.load() == false && turns.empty())
+				jobReady.wait(guard);
+			if (stopping.load())
+				return;
+			string game = turns.front();
+			turns.pop_front();
+			job = queues[game].front();
+			queues[game].pop_front();
+			running.insert(game);
+		}
+		this->finish(job, this->search(job));
+	}
+}
+
+/**
+ * Reads one request line from a client. A well-formed MOVE request
+ * is scheduled; anything else is answered right away with an error.
+ *
+ * @param client Id of the client that sent the line
+ * @param line The request, without its newline
+ *
+ * @return string An answer to send right away, or "" if the request was scheduled
+ */
+string AnalysisService::handleLine(int client, const string & line)
+{
+	istringstream in(line);
+	string command;
+	Job job;
+	job.client = client;
+	in >> command >> job.request;
+	if (command != "MOVE")
+		return "ERR " + (job.request.empty() ? string("-") : job.request) + " unknown command";
+	if (!(in >> job.game >> job.boardNum >> job.player >> job.budgetMs >> job.cells))
+		return "ERR " + job.request + " malformed request";
+	if (job.boardNum < 1 || job.boardNum > 5)
+		return "ERR " + job.request + " board must be 1 to 5";
+	if (job.player != 'B' && job.player != 'G')
+		return "ERR " + job.request + " player must be B or G";
+	if (job.budgetMs <= 0)
+		return "ERR " + job.request + " budget must be positive";
+	if (job.cells.size() != 36 || job.cells.find_first_not_of("BGN") != string::npos)
+		return "ERR " + job.request + " cells must be 36 of B, G or N";
+	if (job.cells.find('N') == string::npos)
+		return "ERR " + job.request + " game is over";
+	if (job.budgetMs > maxBudgetMs)
+		job.budgetMs = maxBudgetMs;
+	this->schedule(job);
+	return "";
+}
+
+/**
+ * Queues a job behind the other jobs of its game. If the game has
+ * no turn yet, it gets one at the back of the round robin.
+ *
+ * @param job The job to queue
+ */
+void AnalysisService::schedule(const Job & job)
+{
+	lock_guard<mutex> guard(lock);
+	deque<Job> & queue = queues[job.game];
+	queue.push_back(job);
+	if (queue.size() == 1 && running.count(job.game) == 0)
+	{
+		turns.push_back(job.game);
+		jobReady.notify_one();
+	}
+}
+
+/**
+ * Drops the queued jobs of a client that left. A game that has no jobs
+ * left loses its turn; one that is being searched is cleaned up by finish().
+ *
+ * @param client Id of the client that left
+ */
+void AnalysisService::dropClient(int client)
+{
+	lock_guard<mutex> guard(lock);
+	for (map<string, deque<Job> >::iterator it = queues.begin(); it != queues.end(); )
+	{
+		deque<Job> & queue = it->second;
+		for (deque<Job>::iterator job = queue.begin(); job != queue.end(); )
+			job = (job->client == client) ? queue.erase(job) : job + 1;
+		if (queue.empty() && running.count(it->first) == 0)
+		{
+			turns.erase(remove(turns.begin(), turns.end(), it->first), turns.end());
+			queues.erase(it++);
+		}
+		else
+			++it;
+	}
+}
+
+/**
+ * Hands the answer of a job to the thread that runs run(),
+ * and gives the job's game its next turn if it has more jobs.
+ *
+ * @param job The job that was searched
+ * @param answer The answer to send to the job's client
+ */
+void AnalysisService::finish(const Job & job, const string & answer)
+{
+	{
+		lock_guard<mutex> guard(lock);
+		answers.push_back(make_pair(job.client, answer));
+		running.erase(job.game);
+		if (queues[job.game].empty())
+			queues.erase(job.game);
+		else
+		{
+			turns.push_back(job.game);
+			jobReady.notify_one();
+		}
+	}
+	char wake = 0;
+	if (write(wakeFds[1], &wake, 1) < 0)
+		return;
+}
+
+/**
+ * Searches a job's move with iterative deepening until its time budget runs out.
+ *
+ * @param job The job to search
+ *
+ * @return string The OK answer of the job
+ */
+string AnalysisService::search(const Job & job)
+{
+	Board * board = new Board(boards[job.boardNum - 1]);
+	for (int i = 0; i < 36; i++)
+		board->setPlayer(i / 6, i % 6, job.cells[i]);
+
+	Minimax::Options options(true);
+	options.maxDepth = maxDepth;
+	options.stop = &stopping;
+	options.deadline = chrono::steady_clock::now() + chrono::milliseconds(job.budgetMs);
+	//workers cannot share rand(), so ties are broken with a state of the
+	//job's own, seeded from its game and request (FNV-1a), which also makes
+	//the same request get the same answer.
+	unsigned int randomState = 2166136261u;
+	string key = job.game + " " + job.request;
+	for (unsigned int i = 0; i < key.size(); i++)
+		randomState = (randomState ^ (unsigned char)key[i]) * 16777619u;
+	options.randomState = &randomState;
+	DeepeningSearch search(job.player, board, options);
+	int row = 0; int col = 0;
+	search.chooseNextMove(row, col);
+	delete board;
+
+	ostringstream answer;
+	answer << "OK " << job.request << " " << row << " " << col << " "
+	       << search.getCompletedDepth() << " " << search.getNumNodes();
+	return answer.str();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file service.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "board.h"
+
+using namespace std;
+
+/**
+ * This class serves AI moves for many independent War Games at once.
+ * Clients connect to a Unix domain socket and send one request per line:
+ *
+ * MOVE <request> <game> <board> <player> <budget ms> <cells>
+ *
+ * where board is 1 to 5 like in aimp2, player is B or G, and cells are
+ * the 36 pieces row by row, each B, G or N. Each request is answered
+ * when its search is done, so answers can come in another order:
+ *
+ * OK <request> <row> <col> <depth searched> <nodes>
+ * ERR <request> <reason>
+ *
+ * Searches run on a pool of worker threads. Games take turns in round
+ * robin order, one search per game at a time, and every search stops
+ * at its time budget (capped by the service), so a game that asks for
+ * many or deep searches cannot starve the others. Client sockets are
+ * non-blocking, and answers wait in a per-client buffer until the socket
+ * takes them, so a client that stops reading only holds up its own answers.
+ * The jobs of a client that leaves are dropped, and a client that sends
+ * more than MAX_INPUT_BYTES without a newline is hung up on.
+ */
+class AnalysisService
+{
+	public:
+		AnalysisService(const char * socketPath, int numWorkers, int maxDepth, int maxBudgetMs);
+		~AnalysisService();
+
+		bool run();
+		void stop();
+
+	private:
+		/**
+		 * Job is one MOVE request waiting for, or being given, a search.
+		 */
+		class Job
+		{
+			public:
+				int client;
+				string request;
+				string game;
+				int boardNum;
+				char player;
+				int budgetMs;
+				string cells;
+		};
+
+		//most bytes of a request line that are held while its newline has not come.
+		static const size_t MAX_INPUT_BYTES = 4096;
+
+		string socketPath;
+		int numWorkers;
+		int maxDepth;
+		int maxBudgetMs;
+		Board * boards[5];
+		atomic<bool> stopping;
+		//writing to wakeFds[1] wakes up the thread that runs run().
+		int wakeFds[2];
+
+		//the scheduler: jobs waiting per game, the games whose turn is next,
+		//and the games being searched right now.
+		mutex lock;
+		condition_variable jobReady;
+		map<string, deque<Job> > queues;
+		deque<string> turns;
+		set<string> running;
+		//answers waiting to be sent, with the client they are for.
+		deque<pair<int, string> > answers;
+		vector<thread> workers;
+
+		void work();
+		string handleLine(int client, const string & line);
+		void schedule(const Job & job);
+		void dropClient(int client);
+		void finish(const Job & job, const string & answer);
+		string search(const Job & job);
+};
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file servicemain.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <iostream>
+#include <signal.h>
+#include <stdlib.h>
+#include "minimax.h"
+#include "service.h"
+
+using namespace std;
+
+//the service that the signal handler stops.
+static AnalysisService * service = NULL;
+
+/**
+ * Stops the service when the process is interrupted or terminated.
+ *
+ * @param signal Number of the signal that was caught
+ */
+static void stopService(int signal)
+{
+	if (service != NULL)
+		service->stop();
+}
+
+/**
+ * The main function of the analysis service, which serves AI moves
+ * for many War Games at once over a Unix domain socket:
+ *
+ * ./wargamed SOCKET [WORKERS] [DEPTH] [MAX BUDGET MS]
+ *
+ * WORKERS is the number of searches that run at once (default 4),
+ * DEPTH is the deepest search for a move (default DEPTH_OF_MINIMAX),
+ * and MAX BUDGET MS caps the time budget of each request (default 5000).
+ * The protocol is described in service.h. Ctrl-C stops the service.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	if (argc < 2)
+	{
+		cout << "Usage: ./wargamed SOCKET [WORKERS] [DEPTH] [MAX BUDGET MS]" << endl;
+		return -1;
+	}
+	int numWorkers = (argc > 2 && atoi(argv[2]) > 0) ? atoi(argv[2]) : 4;
+	int maxDepth = (argc > 3 && atoi(argv[3]) > 0) ? atoi(argv[3]) : Minimax::DEPTH_OF_MINIMAX;
+	int maxBudgetMs = (argc > 4 && atoi(argv[4]) > 0) ? atoi(argv[4]) : 5000;
+
+	service = new AnalysisService(argv[1], numWorkers, maxDepth, maxBudgetMs);
+	signal(SIGINT, stopService);
+	signal(SIGTERM, stopService);
+	//a client that hangs up must not kill the service.
+	signal(SIGPIPE, SIG_IGN);
+	cout << "Serving on " << argv[1] << " with " << numWorkers << " workers" << endl;
+	bool served = service->run();
+	AnalysisService * stopped = service;
+	service = NULL;
+	delete stopped;
+	if (served == false)
+	{
+		cout << "SOCKET ERR: " << argv[1] << " cannot be listened on" << endl;
+		return -1;
+	}
+	return 0;
+}
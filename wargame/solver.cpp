@@ -0,0 +1,279 @@
+/**
+ * @file solver.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "solver.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "stdlib.h"
+
+using namespace std;
+
+/**
+ * Constructor of a Solver. Opens the file of solved values for a Layout,
+ * or creates it if it does not exist yet.
+ * 
+ * @param layout Layout of the board to solve, with at most MAX_CELLS cells
+ * @param filename Name of the file that holds the solved values
+ */
+Solver::Solver(const Layout & layout, const char * filename)
+	: layout(layout)
+{
+	this->fd = -1;
+	this->map = NULL;
+	this->mapBytes = 0;
+	this->table = NULL;
+	this->numEntries = 0;
+	this->numSolved = 0;
+	powersOfThree[0] = 1;
+	for (int i = 1; i <= MAX_CELLS; i++)
+		powersOfThree[i] = powersOfThree[i - 1] * 3;
+	if (layout.numCells > MAX_CELLS)
+		return;
+
+	//there is one entry for each way to fill the cells with empty, Blue or Green.
+	numEntries = powersOfThree[layout.numCells];
+	mapBytes = HEADER_BYTES + numEntries * sizeof(short);
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "WARSOLV", 8);
+	header.size = layout.size;
+	for (int i = 0; i < layout.numCells; i++)
+		header.values[i] = layout.values[i];
+
+	fd = open(filename, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return;
+	struct stat info;
+	fstat(fd, &info);
+	//a new file is grown to its full size, which the file system keeps
+	//sparse, so only the entries that get solved take up disk space.
+	if (info.st_size == 0 && ftruncate(fd, mapBytes) != 0)
+	{
+		close(fd);
+		fd = -1;
+		return;
+	}
+	void * address = mmap(NULL, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (address == MAP_FAILED)
+	{
+		close(fd);
+		fd = -1;
+		return;
+	}
+	map = (unsigned char *)address;
+
+	//a new file gets the header; an old one must have been made for this Layout.
+	if (info.st_size == 0)
+		memcpy(map, &header, sizeof(header));
+	else if ((unsigned long long)info.st_size != mapBytes || memcmp(map, &header, sizeof(header)) != 0)
+	{
+		munmap(map, mapBytes);
+		close(fd);
+		map = NULL;
+		fd = -1;
+		return;
+	}
+	table = (short *)(map + HEADER_BYTES);
+}
+
+/**
+ * Unmaps and closes the file of solved values.
+ */
+Solver::~Solver()
+{
+	if (map != NULL)
+		munmap(map, mapBytes);
+	if (fd >= 0)
+		close(fd);
+}
+
+/**
+ * Tests if the file of solved values could be opened for this Layout.
+ * 
+ * @return boolean
+ */
+bool Solver::isOpen()
+{
+	return this->table != NULL;
+}
+
+/**
+ * Finds the exact game value of a position, solving it and every
+ * position after it that is not solved yet.
+ * 
+ * @param position Position to solve
+ * 
+ * @return int Player Blue's final score minus Player Green's, with perfect play
+ */
+int Solver::solve(const Position & position)
+{
+	int value = 0;
+	if (this->lookup(position, value))
+		return value;
+
+	//BASE CASE=================================================================
+	if (position.isGameOver(layout))
+	{
+		value = position.scoreDiff(layout);
+	}
+	//RECURSIVE CASE============================================================
+	else
+	{
+		char player = playerToMove(position);
+		Move moves[Layout::MAX_CELLS];
+		int numMoves = position.generateMoves(layout, player, moves);
+		value = (player == 'B') ? -BIAS : BIAS;
+		for (int i = 0; i < numMoves; i++)
+		{
+			Position child = position;
+			child.makeMove(moves[i], player);
+			int childValue = this->solve(child);
+			if (player == 'B' && childValue > value) value = childValue;
+			if (player == 'G' && childValue < value) value = childValue;
+		}
+	}
+	table[this->rank(position)] = value + BIAS;
+	numSolved++;
+	return value;
+}
+
+/**
+ * Looks up the game value of a position in O(1), without solving it.
+ * 
+ * @param position Position to look up
+ * @param value Int that will hold the game value, if the position is solved
+ * 
+ * @return True if the position is solved
+ */
+bool Solver::lookup(const Position & position, int & value)
+{
+	short entry = table[this->rank(position)];
+	if (entry == 0)
+		return false;
+	value = entry - BIAS;
+	return true;
+}
+
+/**
+ * Finds whose turn it is. Every move takes exactly one empty piece and
+ * Player Blue moves first, so it is Blue's turn when an even number
+ * of pieces are taken.
+ * 
+ * @param position Position of the game
+ * 
+ * @return char 'B' or 'G'
+ */
+char Solver::playerToMove(const Position & position)
+{
+	int numTaken = __builtin_popcountll(position.blue | position.green);
+	return (numTaken % 2 == 0) ? 'B' : 'G';
+}
+
+/**
+ * Finds the ternary rank of a position, its index in the table.
+ * Cell i counts 3^i times 0 if empty, 1 if Blue's, or 2 if Green's.
+ * 
+ * @param position Position to rank
+ * 
+ * @return unsigned long long between 0 and getNumEntries() - 1
+ */
+unsigned long long Solver::rank(const Position & position)
+{
+	unsigned long long index = 0;
+	unsigned long long taken = position.blue | position.green;
+	while (taken != 0)
+	{
+		int cell = __builtin_ctzll(taken);
+		taken &= taken - 1;
+		index += powersOfThree[cell] * (((position.blue >> cell) & 1) ? 1 : 2);
+	}
+	return index;
+}
+
+/**
+ * Getter function
+ * 
+ * @return numSolved Number of positions solved since the file was opened
+ */
+unsigned long long Solver::getNumSolved()
+{
+	return this->numSolved;
+}
+
+/**
+ * Getter function
+ * 
+ * @return numEntries Number of entries in the table
+ */
+unsigned long long Solver::getNumEntries()
+{
+	return this->numEntries;
+}
+
+/**
+ * Constructor of a PerfectPlayer. Solves the position and every
+ * position one move after it, if they are not solved yet.
+ * 
+ * @param currPlayer Char of the player to move
+ * @param layout Layout of the board
+ * @param position Position of the game, which must not be over
+ * @param solver Solver of the board's Layout
+ */
+PerfectPlayer::PerfectPlayer(char currPlayer, const Layout & layout, const Position & position, Solver * solver)
+	: layout(layout), position(position)
+{
+	this->player = currPlayer;
+	this->solver = solver;
+	this->value = solver->solve(position);
+	this->numNodes = 1;
+}
+
+/**
+ * Function that stores the coordinate of a perfect move to the params.
+ * If more than one move keeps the game value, one of them is randomly picked.
+ * 
+ * @param row Int that will hold the row of the move to make.
+ * @param col Int that will hold the col of the move to make.
+ */
+void PerfectPlayer::chooseNextMove(int & row, int & col)
+{
+	Move moves[Layout::MAX_CELLS];
+	int numMoves = position.generateMoves(layout, player, moves);
+	vector<int> listOfBestMoves;
+	for (int i = 0; i < numMoves; i++)
+	{
+		Position child = position;
+		child.makeMove(moves[i], player);
+		numNodes++;
+		if (solver->solve(child) == value)
+			listOfBestMoves.push_back(moves[i].cell);
+	}
+	int cell = listOfBestMoves.at(rand() % listOfBestMoves.size());
+	row = cell / layout.size;
+	col = cell % layout.size;
+}
+
+/**
+ * Getter function
+ * 
+ * @return value Exact game value of the position
+ */
+int PerfectPlayer::getValue()
+{
+	return this->value;
+}
+
+/**
+ * Getter function
+ * 
+ * @return numNodes Number of positions looked up
+ */
+int PerfectPlayer::getNumNodes()
+{
+	return this->numNodes;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file solver.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "position.h"
+
+/**
+ * This class strongly solves small War Game boards, up to 4x4. A 4x4 board
+ * has 3^16 entries, a table of 86 MB that is solved in about a minute; a
+ * 5x5 board would need 3^25 entries, about 1.7 TB and days of CPU, so it
+ * is not allowed.
+ * It finds the exact game value of every position reachable from the empty
+ * board: Player Blue's final score minus Player Green's, when Blue plays
+ * to make it as high as possible and Green as low as possible.
+ * 
+ * The values live in a file that is memory-mapped, with one entry for every
+ * way to fill the board's cells with empty, Blue or Green pieces, found by
+ * the position's ternary rank. So a solved file can be reopened later and
+ * any position looked up in O(1).
+ */
+class Solver
+{
+	public:
+		//a square board with more cells than this has too many positions to map.
+		static const int MAX_CELLS = 16;
+
+		Solver(const Layout & layout, const char * filename);
+		~Solver();
+
+		bool isOpen();
+		int solve(const Position & position);
+		bool lookup(const Position & position, int & value);
+		static char playerToMove(const Position & position);
+		unsigned long long rank(const Position & position);
+		unsigned long long getNumSolved();
+		unsigned long long getNumEntries();
+
+	private:
+		/**
+		 * Header is the start of the file. It records the Layout that was
+		 * solved, so that a file is never used with another Layout.
+		 */
+		class Header
+		{
+			public:
+				char magic[8];
+				int size;
+				int values[Layout::MAX_CELLS];
+		};
+
+		//entries are stored as value + BIAS, so 0 (a new, empty file) means unsolved.
+		static const int BIAS = 16384;
+		static const int HEADER_BYTES = 256;
+
+		Layout layout;
+		int fd;
+		unsigned char * map;
+		unsigned long long mapBytes;
+		short * table;
+		unsigned long long numEntries;
+		unsigned long long numSolved;
+		unsigned long long powersOfThree[MAX_CELLS + 1];
+};
+
+/**
+ * This class is an AI Player with perfect play on a solved board.
+ * It is used like Minimax: construct it on a position, then
+ * call chooseNextMove.
+ */
+class PerfectPlayer
+{
+	public:
+		PerfectPlayer(char currPlayer, const Layout & layout, const Position & position, Solver * solver);
+
+		void chooseNextMove(int & row, int & col);
+		int getValue();
+		int getNumNodes();
+
+	private:
+		Layout layout;
+		Position position;
+		char player;
+		Solver * solver;
+		int value;
+		int numNodes;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file solvermain.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <iostream>
+#include <stdlib.h>
+#include "analysistree.h"
+#include "board.h"
+#include "solver.h"
+#include "timing.h"
+
+using namespace std;
+
+/**
+ * The main function of the solver tool, which strongly solves
+ * a small War Game board and stores its values in a file:
+ *
+ * ./solver BOARD SIZE FILE [DEPTH]
+ *
+ * BOARD is 1 to 5, like in aimp2, and the board that is solved is its
+ * top-left SIZE x SIZE corner (SIZE is at most 4). FILE is created if it
+ * does not exist, and reused if it does.
+ *
+ * If DEPTH is given, the solver is used as an oracle for the heuristic
+ * AI: an alpha-beta AI Player searching DEPTH deep plays both sides of
+ * 100 War Games, and each of its moves is checked against perfect play.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	if (argc < 4 || atoi(argv[1]) < 1 || atoi(argv[1]) > 5
+	    || atoi(argv[2]) < 1 || atoi(argv[2]) * atoi(argv[2]) > Solver::MAX_CELLS)
+	{
+		cout << "Usage: ./solver BOARD SIZE FILE [DEPTH]" << endl;
+		return -1;
+	}
+	int size = atoi(argv[2]);
+
+	//take the values of the top-left SIZE x SIZE corner of the Board.
+	Board * board = new Board(atoi(argv[1]));
+	int values[Layout::MAX_CELLS];
+	for (int i = 0; i < size; i++)
+	{
+		for (int j = 0; j < size; j++)
+		{
+			values[i * size + j] = board->getValue(i, j);
+		}
+	}
+	delete board;
+	Layout layout(size, values);
+
+	Solver solver(layout, argv[3]);
+	if (solver.isOpen() == false)
+	{
+		cout << "FILE ERR: " << argv[3] << " cannot be opened for this board" << endl;
+		return -1;
+	}
+
+	//solve every position reachable from the empty board.
+	Stopwatch begin;
+	int value = solver.solve(Position());
+	Stopwatch end;
+	cout << "Game value with perfect play (Blue - Green): " << value << endl;
+	cout << "Positions solved now: " << solver.getNumSolved()
+	     << " out of " << solver.getNumEntries() << " entries, in "
+	     << end.secondsSince(begin) << " seconds" << endl;
+	if (argc < 5)
+		return 0;
+
+	//check the heuristic AI Player's moves against perfect play.
+	int depth = atoi(argv[4]);
+	int numMoves = 0;
+	int numPerfectMoves = 0;
+	long long totalLoss = 0;
+	srand(1);
+	for (int game = 0; game < 100; game++)
+	{
+		Position position;
+		while (position.isGameOver(layout) == false)
+		{
+			char player = Solver::playerToMove(position);
+			int best = solver.solve(position);
+			AnalysisTree tree(player, layout, position, true, depth);
+			int row = 0; int col = 0;
+			tree.chooseNextMove(row, col);
+			position.putPiece(layout, row * size + col, player);
+			//how many points the move gave away compared to perfect play.
+			int loss = solver.solve(position) - best;
+			if (player == 'B') loss = -loss;
+			numMoves++;
+			if (loss == 0) numPerfectMoves++;
+			totalLoss += loss;
+		}
+	}
+	cout << "Alpha-beta AI of depth " << depth << ": "
+	     << 100.0 * numPerfectMoves / numMoves << "% perfect moves, "
+	     << double(totalLoss) / numMoves << " points lost per move" << endl;
+	return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file sprt.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "sprt.h"
+#include <cmath>
+
+using namespace std;
+
+/**
+ * Constructor of a test that has not seen any pairs yet.
+ *
+ * @param elo0 Elo difference of the first hypothesis
+ * @param elo1 Elo difference of the second hypothesis, above elo0
+ * @param alpha Chance of accepting elo1 when elo0 holds
+ * @param beta Chance of accepting elo0 when elo1 holds
+ */
+SPRT::SPRT(double elo0, double elo1, double alpha, double beta)
+{
+	this->elo0 = elo0;
+	this->elo1 = elo1;
+	this->lowerBound = log(beta / (1 - alpha));
+	this->upperBound = log((1 - beta) / alpha);
+	for (int i = 0; i < 5; i++)
+		counts[i] = 0;
+}
+
+/**
+ * Counts a pair of War Games.
+ *
+ * @param halfPoints Half-points A scored over the pair, 0 to 4
+ */
+void SPRT::addPair(int halfPoints)
+{
+	counts[halfPoints]++;
+}
+
+/**
+ * Getter function
+ *
+ * @return int Number of pairs counted
+ */
+int SPRT::getNumPairs()
+{
+	int numPairs = 0;
+	for (int i = 0; i < 5; i++)
+		numPairs += counts[i];
+	return numPairs;
+}
+
+/**
+ * Getter function
+ *
+ * @param halfPoints Half-points A scored over a pair, 0 to 4
+ *
+ * @return long long Number of pairs A scored that many half-points in
+ */
+long long SPRT::getPairCount(int halfPoints)
+{
+	return this->counts[halfPoints];
+}
+
+/**
+ * Finds A's score per War Game, from 0 to 1.
+ *
+ * @return double The score, or 0.5 if no pairs were counted
+ */
+double SPRT::getScore()
+{
+	double mean = 0; double variance = 0;
+	this->getMoments(mean, variance);
+	return mean;
+}
+
+/**
+ * Finds how many Elo A is stronger than B, from A's score.
+ *
+ * @return double The Elo difference
+ */
+double SPRT::getElo()
+{
+	return scoreToElo(this->getScore());
+}
+
+/**
+ * Finds the 95% confidence interval of the Elo difference.
+ *
+ * @param lower Double that will hold the lower end of the interval
+ * @param upper Double that will hold the upper end of the interval
+ */
+void SPRT::getEloInterval(double & lower, double & upper)
+{
+	double mean = 0; double variance = 0;
+	this->getMoments(mean, variance);
+	int numPairs = this->getNumPairs();
+	double margin = (numPairs > 0) ? 1.96 * sqrt(variance / numPairs) : 0.5;
+	lower = scoreToElo(mean - margin);
+	upper = scoreToElo(mean + margin);
+}
+
+/**
+ * Finds the log-likelihood ratio of elo1 over elo0. Under a normal model
+ * of the pair scores with their observed variance, it is
+ * n (s1 - s0) (2 mean - s0 - s1) / (2 variance), where s0 and s1 are the
+ * scores the two hypotheses expect.
+ *
+ * @return double The ratio, or 0 while the pair scores do not vary
+ */
+double SPRT::getLlr()
+{
+	double mean = 0; double variance = 0;
+	this->getMoments(mean, variance);
+	if (variance <= 0)
+		return 0;
+	double score0 = eloToScore(elo0);
+	double score1 = eloToScore(elo1);
+	return this->getNumPairs() * (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance);
+}
+
+/**
+ * Getter function
+ *
+ * @return lowerBound Ratio at or below which elo0 is accepted
+ */
+double SPRT::getLowerBound()
+{
+	return this->lowerBound;
+}
+
+/**
+ * Getter function
+ *
+ * @return upperBound Ratio at or above which elo1 is accepted
+ */
+double SPRT::getUpperBound()
+{
+	return this->upperBound;
+}
+
+/**
+ * Compares the log-likelihood ratio to its bounds.
+ *
+ * @return int ACCEPT_ELO0, ACCEPT_ELO1, or CONTINUE if more pairs are needed
+ */
+int SPRT::getDecision()
+{
+	double llr = this->getLlr();
+	if (llr <= lowerBound)
+		return ACCEPT_ELO0;
+	if (llr >= upperBound)
+		return ACCEPT_ELO1;
+	return CONTINUE;
+}
+
+/**
+ * Finds the mean and the variance of A's score per War Game over the pairs.
+ *
+ * @param mean Double that will hold the mean, 0.5 if no pairs were counted
+ * @param variance Double that will hold the variance
+ */
+void SPRT::getMoments(double & mean, double & variance)
+{
+	int numPairs = this->getNumPairs();
+	mean = 0.5;
+	variance = 0;
+	if (numPairs == 0)
+		return;
+	mean = 0;
+	for (int i = 0; i < 5; i++)
+		mean += counts[i] * (i / 4.0);
+	mean /= numPairs;
+	for (int i = 0; i < 5; i++)
+		variance += counts[i] * (i / 4.0 - mean) * (i / 4.0 - mean);
+	variance /= numPairs;
+}
+
+/**
+ * Finds the score per War Game that an Elo difference predicts.
+ *
+ * @param elo The Elo difference
+ *
+ * @return double The score, from 0 to 1
+ */
+double SPRT::eloToScore(double elo)
+{
+	return 1 / (1 + pow(10, -elo / 400));
+}
+
+/**
+ * Finds the Elo difference that predicts a score per War Game. Scores
+ * of 0 and 1 are moved slightly inward, to keep the difference finite.
+ *
+ * @param score The score, from 0 to 1
+ *
+ * @return double The Elo difference
+ */
+double SPRT::scoreToElo(double score)
+{
+	score = fmin(fmax(score, 0.001), 0.999);
+	return -400 * log10(1 / score - 1);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file sprt.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef SPRT_H
+#define SPRT_H
+
+/**
+ * This class is a sequential probability ratio test of whether an engine
+ * A is stronger than an engine B. It is fed pairs of War Games that only
+ * differ by which engine plays which color, and it counts how many pairs
+ * A scored 0, 1, 2, 3 and 4 half-points in (a win is 2 half-points, a
+ * draw 1). Scoring pairs, instead of War Games, takes out most of the
+ * luck of the Board and the color.
+ *
+ * The test weighs the hypothesis that A is elo0 Elo stronger than B
+ * against the hypothesis that it is elo1 Elo stronger. After each pair,
+ * the log-likelihood ratio of the second over the first is compared to
+ * its bounds: once it falls below the lower bound the first hypothesis
+ * is accepted, and once it rises above the upper bound the second one
+ * is. The ratio uses a normal model of the pair scores (the generalized
+ * SPRT), and alpha and beta are the chances of accepting the wrong one.
+ *
+ * This file stays apart from minimax.h, whose INFINITY clashes with cmath.
+ */
+class SPRT
+{
+	public:
+		//what the test has concluded so far.
+		static const int ACCEPT_ELO0 = -1;
+		static const int CONTINUE = 0;
+		static const int ACCEPT_ELO1 = 1;
+
+		SPRT(double elo0, double elo1, double alpha, double beta);
+
+		void addPair(int halfPoints);
+
+		int getNumPairs();
+		long long getPairCount(int halfPoints);
+		double getScore();
+		double getElo();
+		void getEloInterval(double & lower, double & upper);
+		double getLlr();
+		double getLowerBound();
+		double getUpperBound();
+		int getDecision();
+
+	private:
+		double elo0;
+		double elo1;
+		double lowerBound;
+		double upperBound;
+		//number of pairs A scored 0 to 4 half-points in.
+		long long counts[5];
+
+		void getMoments(double & mean, double & variance);
+		static double eloToScore(double elo);
+		static double scoreToElo(double score);
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file timing.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "timing.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Default Constructor
+ * Starts the timer now.
+ */
+Stopwatch::Stopwatch()
+{
+	this->restart();
+}
+
+/**
+ * Starts the timer again from now.
+ */
+void Stopwatch::restart()
+{
+	this->begin = chrono::steady_clock::now();
+}
+
+/**
+ * Time since the timer was started.
+ * 
+ * @return double Wall-clock seconds
+ */
+double Stopwatch::seconds() const
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * Time from when an earlier timer was started until this timer was started.
+ * 
+ * @param earlier Timer started earlier
+ * 
+ * @return double Wall-clock seconds
+ */
+double Stopwatch::secondsSince(const Stopwatch & earlier) const
+{
+	return chrono::duration<double>(begin - earlier.begin).count();
+}
+
+/**
+ * Constructor of a LatencyRecorder
+ * 
+ * @param name Name to print in front of the percentiles
+ */
+LatencyRecorder::LatencyRecorder(const string & name)
+{
+	this->name = name;
+}
+
+/**
+ * Adds one latency sample.
+ * 
+ * @param seconds The latency in seconds
+ */
+void LatencyRecorder::record(double seconds)
+{
+	samples.push_back(seconds);
+}
+
+/**
+ * Getter function
+ * 
+ * @return int Number of samples
+ */
+int LatencyRecorder::count() const
+{
+	return samples.size();
+}
+
+/**
+ * Finds a percentile of the samples with the nearest-rank method.
+ * 
+ * @param p Percentile between 0 and 100
+ * 
+ * @return double Seconds, 0 if there are no samples
+ */
+double LatencyRecorder::percentile(double p) const
+{
+	if (samples.empty())
+		return 0;
+	vector<double> sorted(samples);
+	//the nearest rank is ceil(p/100 * n), counted from 1.
+	unsigned int rank = (unsigned int)(p / 100 * sorted.size());
+	if (rank * 100.0 < p * sorted.size())
+		rank++;
+	if (rank < 1) rank = 1;
+	if (rank > sorted.size()) rank = sorted.size();
+	nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+	return sorted[rank - 1];
+}
+
+/**
+ * Finds the largest sample.
+ * 
+ * @return double Seconds, 0 if there are no samples
+ */
+double LatencyRecorder::maximum() const
+{
+	if (samples.empty())
+		return 0;
+	return *max_element(samples.begin(), samples.end());
+}
+
+/**
+ * Prints the percentiles of the samples in milliseconds on one line.
+ * 
+ * @param out Stream to print to
+ */
+void LatencyRecorder::print(ostream & out) const
+{
+	out << name << ": n=" << count()
+	    << ", p50=" << percentile(50) * 1000 << " ms"
+	    << ", p95=" << percentile(95) * 1000 << " ms"
+	    << ", p99=" << percentile(99) * 1000 << " ms"
+	    << ", max=" << maximum() * 1000 << " ms" << endl;
+}
+
+/**
+ * Constructor of a TraceWriter
+ * Opens the trace file and starts the trace clock.
+ * 
+ * @param filename Name of the trace file to write
+ */
+TraceWriter::TraceWriter(const char * filename)
+	: out(filename)
+{
+	this->firstEvent = true;
+	out << "{\"traceEvents\":[" << endl;
+}
+
+/**
+ * Closes the trace so that it is valid JSON.
+ */
+TraceWriter::~TraceWriter()
+{
+	out << endl << "]}" << endl;
+}
+
+/**
+ * Writes one complete span. Each game is its own process in the trace,
+ * and each player its own thread (1 for Blue, 2 for Green).
+ * 
+ * @param name Name of the span, such as "search"
+ * @param game Number of the game, starting at 1
+ * @param player Char of the player whose move the span belongs to
+ * @param begin Timer started when the span began
+ * @param end Timer started when the span ended
+ */
+void TraceWriter::span(const string & name, int game, char player,
+                       const Stopwatch & begin, const Stopwatch & end)
+{
+	if (firstEvent == false)
+		out << "," << endl;
+	firstEvent = false;
+	out << "{\"name\":\"" << name << "\",\"ph\":\"X\""
+	    << ",\"ts\":" << begin.secondsSince(origin) * 1000000
+	    << ",\"dur\":" << end.secondsSince(begin) * 1000000
+	    << ",\"pid\":" << game
+	    << ",\"tid\":" << (player == 'B' ? 1 : 2)
+	    << ",\"args\":{\"player\":\"" << (player == 'B' ? "Blue" : "Green") << "\"}}";
+}
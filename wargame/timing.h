@@ -0,0 +1,70 @@
+/**
+ * @file timing.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * This class is a monotonic wall-clock timer.
+ * Unlike clock(), it measures real time, so time spent waiting
+ * or in other threads is neither hidden nor double counted.
+ */
+class Stopwatch
+{
+	public:
+		Stopwatch();
+		void restart();
+		double seconds() const;
+		double secondsSince(const Stopwatch & earlier) const;
+
+	private:
+		chrono::steady_clock::time_point begin;
+};
+
+/**
+ * This class collects latency samples and reports
+ * their percentiles (p50, p95, p99) and their maximum.
+ */
+class LatencyRecorder
+{
+	public:
+		LatencyRecorder(const string & name);
+		void record(double seconds);
+		int count() const;
+		double percentile(double p) const;
+		double maximum() const;
+		void print(ostream & out) const;
+
+	private:
+		string name;
+		vector<double> samples;
+};
+
+/**
+ * This class writes spans to a file in the Chrome trace format,
+ * which chrome://tracing and Perfetto can open.
+ */
+class TraceWriter
+{
+	public:
+		TraceWriter(const char * filename);
+		~TraceWriter();
+		void span(const string & name, int game, char player,
+		          const Stopwatch & begin, const Stopwatch & end);
+
+	private:
+		ofstream out;
+		Stopwatch origin;
+		bool firstEvent;
+};
+
+#endif
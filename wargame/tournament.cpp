@@ -0,0 +1,538 @@
+/**
+ * @file tournament.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "tournament.h"
+#include <errno.h>
+#include <iostream>
+#include <poll.h>
+#include <signal.h>
+#include <sstream>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "timing.h"
+
+using namespace std;
+
+/**
+ * Default Constructor
+ * An engine with the default alpha-beta settings.
+ */
+Tournament::Engine::Engine()
+	: options(true)
+{
+	this->network = NULL;
+	this->cache = NULL;
+}
+
+/**
+ * Constructor of a Tournament without engines.
+ *
+ * @param numWorkers Number of worker processes that play War Games at once
+ * @param unitSeconds Time limit of a unit, after which its worker is taken as hung
+ */
+Tournament::Tournament(int numWorkers, double unitSeconds)
+{
+	this->numWorkers = numWorkers;
+	this->unitSeconds = unitSeconds;
+	this->numRestarts = 0;
+	this->seconds = 0;
+}
+
+/**
+ * Frees the engines' Networks and caches.
+ */
+Tournament::~Tournament()
+{
+	for (unsigned int i = 0; i < engines.size(); i++)
+	{
+		delete engines[i].network;
+		delete engines[i].cache;
+	}
+}
+
+/**
+ * Adds an engine to the tournament (see tournament.h for its settings).
+ *
+ * @param spec The engine, as NAME:SETTINGS or just SETTINGS
+ *
+ * @return False if the settings are not understood
+ */
+bool Tournament::addEngine(const string & spec)
+{
+	Engine engine;
+	if (parseEngine(spec, engine) == false)
+		return false;
+	engines.push_back(engine);
+	return true;
+}
+
+/**
+ * Reads an engine's settings (see tournament.h). The caller owns the
+ * Network and cache of the engine, unless the settings are not understood.
+ *
+ * @param spec The engine, as NAME:SETTINGS or just SETTINGS
+ * @param engine Engine that will hold the settings
+ *
+ * @return False if the settings are not understood
+ */
+bool Tournament::parseEngine(const string & spec, Engine & engine)
+{
+	size_t colon = spec.find(':');
+	engine.name = (colon == string::npos) ? spec : spec.substr(0, colon);
+	string settings = (colon == string::npos) ? spec : spec.substr(colon + 1);
+	istringstream tokens(settings);
+	string token;
+	while (getline(tokens, token, '+'))
+	{
+		if (token == "ab")
+			engine.options.enableAlphaBeta = true;
+		else if (token == "mm")
+			engine.options.enableAlphaBeta = false;
+		else if (token == "bound")
+			engine.options.enableBoundPruning = true;
+		else if (token == "lmr")
+			engine.options.enableLateMoveReductions = true;
+		else if (token == "qs")
+			engine.options.enableQuiescence = true;
+		else if (token.compare(0, 6, "depth=") == 0 && atoi(token.c_str() + 6) > 0)
+			engine.options.maxDepth = atoi(token.c_str() + 6);
+		else if (token.compare(0, 6, "cache=") == 0 && engine.cache == NULL)
+		{
+			engine.cache = new PositionCache();
+			engine.options.cache = engine.cache;
+			if (engine.cache->open(token.c_str() + 6, CACHE_BYTES) == false)
+			{
+				delete engine.network;
+				delete engine.cache;
+				return false;
+			}
+		}
+		else if (token.compare(0, 6, "nodes=") == 0 && atoll(token.c_str() + 6) > 0)
+			engine.options.maxNodes = atoll(token.c_str() + 6);
+		else if (token.compare(0, 7, "memory=") == 0 && atoll(token.c_str() + 7) > 0)
+			engine.options.maxBytes = atoll(token.c_str() + 7) * 1024;
+		else if (token.compare(0, 5, "nnue=") == 0 && engine.network == NULL)
+		{
+			engine.network = new Network();
+			engine.options.network = engine.network;
+			if (engine.network->load(token.c_str() + 5) == false)
+			{
+				delete engine.network;
+				delete engine.cache;
+				return false;
+			}
+		}
+		else
+		{
+			delete engine.network;
+			delete engine.cache;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Splits the tournament into units: every pair of engines plays on
+ * every Board, once as each color, with each seed. The two War Games of
+ * a pair that only differ by color use the same seed.
+ *
+ * @param numSeeds Number of seeds, which are 1 to numSeeds
+ */
+void Tournament::schedule(int numSeeds)
+{
+	for (unsigned int a = 0; a < engines.size(); a++)
+	{
+		for (unsigned int b = a + 1; b < engines.size(); b++)
+		{
+			for (int boardNum = 1; boardNum <= 5; boardNum++)
+			{
+				for (int seed = 1; seed <= numSeeds; seed++)
+				{
+					for (int color = 0; color < 2; color++)
+					{
+						Unit unit;
+						unit.blue = (color == 0) ? a : b;
+						unit.green = (color == 0) ? b : a;
+						unit.boardNum = boardNum;
+						unit.seed = seed;
+						unit.attempts = 0;
+						unit.done = false;
+						units.push_back(unit);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Plays every unit on the worker processes, replacing workers that
+ * crash or hang, until each unit is played or has failed MAX_ATTEMPTS times.
+ *
+ * @return True if every unit was played
+ */
+bool Tournament::run()
+{
+	Stopwatch begin;
+	pending.clear();
+	for (unsigned int i = 0; i < units.size(); i++)
+	{
+		if (units[i].done == false)
+			pending.push_back(i);
+	}
+	int numLeft = pending.size();
+	workers.assign(min(numWorkers, numLeft), Worker());
+	for (unsigned int i = 0; i < workers.size(); i++)
+	{
+		workers[i].pid = -1;
+		workers[i].toWorker = workers[i].fromWorker = -1;
+		if (this->startWorker(workers[i]) == false)
+			return false;
+	}
+
+	while (numLeft > 0)
+	{
+		//hand out units to the idle workers, and wait no longer than
+		//until the first busy worker runs out of time.
+		vector<struct pollfd> fds(workers.size());
+		int timeoutMs = -1;
+		for (unsigned int i = 0; i < workers.size(); i++)
+		{
+			if (workers[i].unit < 0 && pending.empty() == false)
+				this->assign(workers[i]);
+			fds[i].fd = workers[i].fromWorker;
+			fds[i].events = POLLIN;
+			fds[i].revents = 0;
+			if (workers[i].unit >= 0)
+			{
+				int leftMs = max(0, (int)((unitSeconds - workers[i].started.seconds()) * 1000) + 1);
+				timeoutMs = (timeoutMs < 0) ? leftMs : min(timeoutMs, leftMs);
+			}
+		}
+		if (poll(&fds[0], fds.size(), timeoutMs) < 0)
+			continue;
+
+		for (unsigned int i = 0; i < workers.size(); i++)
+		{
+			Worker & worker = workers[i];
+			//the worker hung on its unit, so it is killed and replaced.
+			if (fds[i].revents == 0 && worker.unit >= 0 && worker.started.seconds() >= unitSeconds)
+			{
+				kill(worker.pid, SIGKILL);
+				if (this->replaceWorker(worker, numLeft) == false)
+					return false;
+				continue;
+			}
+			if (fds[i].revents == 0)
+				continue;
+			char buffer[4096];
+			ssize_t numRead = read(worker.fromWorker, buffer, sizeof(buffer));
+			//a signal cut the read short, and poll will find the data again.
+			if (numRead < 0 && errno == EINTR)
+				continue;
+			if (numRead > 0)
+			{
+				worker.input.append(buffer, numRead);
+				size_t newline;
+				while ((newline = worker.input.find('\n')) != string::npos)
+				{
+					string line = worker.input.substr(0, newline);
+					worker.input.erase(0, newline + 1);
+					this->readResult(worker, line);
+					numLeft--;
+				}
+				continue;
+			}
+			//the worker crashed.
+			if (this->replaceWorker(worker, numLeft) == false)
+				return false;
+		}
+	}
+
+	//workers exit once their pipe is closed.
+	for (unsigned int i = 0; i < workers.size(); i++)
+		this->stopWorker(workers[i]);
+	Stopwatch end;
+	seconds = end.secondsSince(begin);
+	for (unsigned int i = 0; i < units.size(); i++)
+	{
+		if (units[i].done == false)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Starts a worker process with a pipe to it and a pipe from it.
+ *
+ * @param worker Worker to start, which has no process yet
+ *
+ * @return False if the process could not be started
+ */
+bool Tournament::startWorker(Worker & worker)
+{
+	int down[2];
+	int up[2];
+	if (pipe(down) != 0)
+		return false;
+	if (pipe(up) != 0)
+	{
+		close(down[0]);
+		close(down[1]);
+		return false;
+	}
+	//nothing buffered may be written twice, once by each process.
+	cout.flush();
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		close(down[0]); close(down[1]);
+		close(up[0]); close(up[1]);
+		return false;
+	}
+	if (pid == 0)
+	{
+		//the worker only keeps its own ends of its own pipes, so that
+		//each worker sees its pipe close when the coordinator closes it.
+		close(down[1]);
+		close(up[0]);
+		for (unsigned int i = 0; i < workers.size(); i++)
+		{
+			if (&workers[i] == &worker)
+				continue;
+			if (workers[i].toWorker >= 0) close(workers[i].toWorker);
+			if (workers[i].fromWorker >= 0) close(workers[i].fromWorker);
+		}
+		this->serve(down[0], up[1]);
+		_exit(0);
+	}
+	close(down[0]);
+	close(up[1]);
+	worker.pid = pid;
+	worker.toWorker = down[1];
+	worker.fromWorker = up[0];
+	worker.input.clear();
+	worker.unit = -1;
+	return true;
+}
+
+/**
+ * Closes the pipes of a worker and waits for its process to exit.
+ *
+ * @param worker Worker to stop
+ */
+void Tournament::stopWorker(Worker & worker)
+{
+	if (worker.toWorker >= 0) close(worker.toWorker);
+	if (worker.fromWorker >= 0) close(worker.fromWorker);
+	worker.toWorker = worker.fromWorker = -1;
+	if (worker.pid > 0)
+		waitpid(worker.pid, NULL, 0);
+	worker.pid = -1;
+}
+
+/**
+ * Replaces a worker that crashed or was killed. Its unit is tried
+ * again, unless it already failed MAX_ATTEMPTS times.
+ *
+ * @param worker Worker to replace
+ * @param numLeft Number of units left to play, less one if the unit is given up
+ *
+ * @return False if the new worker could not be started
+ */
+bool Tournament::replaceWorker(Worker & worker, int & numLeft)
+{
+	this->stopWorker(worker);
+	if (worker.unit >= 0)
+	{
+		if (units[worker.unit].attempts < MAX_ATTEMPTS)
+			pending.push_front(worker.unit);
+		else
+			numLeft--;
+	}
+	numRestarts++;
+	return this->startWorker(worker);
+}
+
+/**
+ * Body of a worker process. Each line it reads is a unit,
+ * "<unit> <blue engine> <green engine> <board> <seed>", and each
+ * line it writes is the unit's result, "<unit> <blue score>
+ * <green score> <blue nodes> <green nodes> <blue seconds>
+ * <green seconds> <moves>". It returns once its pipe is closed.
+ *
+ * @param in File descriptor of the pipe from the coordinator
+ * @param out File descriptor of the pipe to the coordinator
+ */
+void Tournament::serve(int in, int out)
+{
+	string input;
+	while (true)
+	{
+		size_t newline;
+		while ((newline = input.find('\n')) == string::npos)
+		{
+			char buffer[256];
+			ssize_t numRead = read(in, buffer, sizeof(buffer));
+			if (numRead <= 0)
+				return;
+			input.append(buffer, numRead);
+		}
+		istringstream line(input.substr(0, newline));
+		input.erase(0, newline + 1);
+		int id = 0; int blue = 0; int green = 0; int boardNum = 0; int seed = 0;
+		line >> id >> blue >> green >> boardNum >> seed;
+
+		srand(seed);
+		SelfPlay::GameRecord record = SelfPlay::playGame(boardNum, engines[blue].options,
+		                                                 engines[green].options);
+		ostringstream result;
+		result << id << " " << record.blueScore << " " << record.greenScore << " "
+		       << record.nodesBlue << " " << record.nodesGreen << " "
+		       << record.secondsBlue << " " << record.secondsGreen << " "
+		       << record.moves << "\n";
+		string message = result.str();
+		size_t sent = 0;
+		while (sent < message.size())
+		{
+			ssize_t numWritten = write(out, message.c_str() + sent, message.size() - sent);
+			if (numWritten <= 0)
+				return;
+			sent += numWritten;
+		}
+	}
+}
+
+/**
+ * Hands the next pending unit to an idle worker.
+ *
+ * @param worker Idle worker
+ *
+ * @return False if the unit could not be sent, in which case the
+ *         worker is about to be found crashed
+ */
+bool Tournament::assign(Worker & worker)
+{
+	int id = pending.front();
+	pending.pop_front();
+	Unit & unit = units[id];
+	unit.attempts++;
+	worker.unit = id;
+	worker.started.restart();
+	ostringstream line;
+	line << id << " " << unit.blue << " " << unit.green << " " << unit.boardNum << " "
+	     << unit.seed << "\n";
+	string message = line.str();
+	return write(worker.toWorker, message.c_str(), message.size()) == (ssize_t)message.size();
+}
+
+/**
+ * Stores the result a worker sent for its unit.
+ *
+ * @param worker Worker that sent the result
+ * @param line The result, without its newline
+ */
+void Tournament::readResult(Worker & worker, const string & line)
+{
+	istringstream in(line);
+	int id = 0;
+	in >> id;
+	Unit & unit = units[id];
+	SelfPlay::GameRecord & record = unit.record;
+	record.boardNum = unit.boardNum;
+	in >> record.blueScore >> record.greenScore >> record.nodesBlue >> record.nodesGreen
+	   >> record.secondsBlue >> record.secondsGreen;
+	getline(in >> ws, record.moves);
+	unit.done = true;
+	worker.unit = -1;
+}
+
+/**
+ * Writes the record of every War Game that was played as CSV,
+ * in the order of the units, whatever worker played them.
+ *
+ * @param out Stream to write the records to
+ */
+void Tournament::writeRecords(ostream & out)
+{
+	out << "unit,blue,green,board,seed,blueScore,greenScore,nodesBlue,nodesGreen,"
+	    << "secondsBlue,secondsGreen,moves" << endl;
+	for (unsigned int i = 0; i < units.size(); i++)
+	{
+		const Unit & unit = units[i];
+		if (unit.done == false)
+			continue;
+		const SelfPlay::GameRecord & record = unit.record;
+		out << i << "," << engines[unit.blue].name << "," << engines[unit.green].name << ","
+		    << unit.boardNum << "," << unit.seed << "," << record.blueScore << ","
+		    << record.greenScore << "," << record.nodesBlue << "," << record.nodesGreen << ","
+		    << record.secondsBlue << "," << record.secondsGreen << "," << record.moves << endl;
+	}
+}
+
+/**
+ * Displays the results of each pair of engines, the work each
+ * engine did, and how fast the tournament was played.
+ *
+ * @param out Stream to display the summary on
+ */
+void Tournament::printSummary(ostream & out)
+{
+	int numEngines = engines.size();
+	//for each engine: War Games, nodes and seconds.
+	vector<long long> games(numEngines, 0);
+	vector<long long> nodes(numEngines, 0);
+	vector<double> engineSeconds(numEngines, 0);
+	for (int a = 0; a < numEngines; a++)
+	{
+		for (int b = a + 1; b < numEngines; b++)
+		{
+			int wins = 0; int draws = 0; int losses = 0;
+			long long margin = 0;
+			for (unsigned int i = 0; i < units.size(); i++)
+			{
+				const Unit & unit = units[i];
+				if (unit.done == false || !((unit.blue == a && unit.green == b)
+				                            || (unit.blue == b && unit.green == a)))
+					continue;
+				int diff = unit.record.blueScore - unit.record.greenScore;
+				if (unit.blue != a) diff = -diff;
+				margin += diff;
+				if (diff > 0) wins++;
+				else if (diff == 0) draws++;
+				else losses++;
+			}
+			int numGames = wins + draws + losses;
+			out << engines[a].name << " vs " << engines[b].name << ": " << numGames
+			    << " War Games, +" << wins << " =" << draws << " -" << losses
+			    << ", margin " << (numGames > 0 ? double(margin) / numGames : 0)
+			    << " per War Game" << endl;
+		}
+	}
+	int numPlayed = 0;
+	for (unsigned int i = 0; i < units.size(); i++)
+	{
+		const Unit & unit = units[i];
+		if (unit.done == false)
+			continue;
+		numPlayed++;
+		games[unit.blue]++;
+		games[unit.green]++;
+		nodes[unit.blue] += unit.record.nodesBlue;
+		nodes[unit.green] += unit.record.nodesGreen;
+		engineSeconds[unit.blue] += unit.record.secondsBlue;
+		engineSeconds[unit.green] += unit.record.secondsGreen;
+	}
+	for (int e = 0; e < numEngines; e++)
+	{
+		out << engines[e].name << ": " << (games[e] > 0 ? nodes[e] / games[e] : 0)
+		    << " nodes and " << (games[e] > 0 ? engineSeconds[e] / games[e] : 0)
+		    << " seconds per War Game" << endl;
+	}
+	out << "Played " << numPlayed << " of " << units.size() << " War Games in " << seconds
+	    << " seconds (" << (seconds > 0 ? numPlayed / seconds : 0) << " per second) with "
+	    << numWorkers << " workers, " << numRestarts << " of which were restarted" << endl;
+}
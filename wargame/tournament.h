@@ -0,0 +1,124 @@
+/**
+ * @file tournament.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <deque>
+#include <ostream>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+#include "minimax.h"
+#include "network.h"
+#include "poscache.h"
+#include "selfplay.h"
+#include "timing.h"
+
+using namespace std;
+
+/**
+ * This class runs a tournament between AI engines on local worker
+ * processes. Every engine plays every other engine on all five Boards,
+ * as each color, once per seed. Each of those War Games is a unit of
+ * work that is handed to an idle worker over a pipe. A worker that
+ * crashes, or hangs on a unit for longer than the unit time limit, is
+ * replaced (a hung worker is killed first), and its unit is tried again
+ * up to MAX_ATTEMPTS times. Workers only ever hold one unit, so a crash
+ * loses one War Game.
+ *
+ * An engine is given as NAME:SETTINGS, or just SETTINGS, where SETTINGS
+ * are joined by '+': "ab" (alpha-beta, the default) or "mm" (minimax),
+ * "bound" (bound pruning, which "nnue" and "qs" turn off), "lmr" (late
+ * move reductions), "qs" (quiescence search), "depth=N", "nodes=N" (a
+ * node budget), "memory=KB" (a memory budget), "nnue=FILE" (a Network's
+ * weight file), and "cache=FILE" (a position cache file, created with
+ * CACHE_BYTES if it does not exist).
+ * For example, "ab+bound+lmr".
+ * Engines that use a cache file share what they found with every War Game
+ * played after, so their results depend on the order units are played in.
+ * An engine with a budget deepens its search one ply at a time and
+ * plays the move of the deepest search that fit in the budget.
+ */
+class Tournament
+{
+	public:
+		static const int MAX_ATTEMPTS = 3;
+		static const long long CACHE_BYTES = 64LL * 1024 * 1024;
+
+		/**
+		 * Engine is one set of AI settings taking part in the tournament.
+		 */
+		class Engine
+		{
+			public:
+				string name;
+				Minimax::Options options;
+				Network * network;
+				PositionCache * cache;
+
+				Engine();
+		};
+
+		Tournament(int numWorkers, double unitSeconds);
+		~Tournament();
+
+		static bool parseEngine(const string & spec, Engine & engine);
+		bool addEngine(const string & spec);
+		void schedule(int numSeeds);
+		bool run();
+
+		void writeRecords(ostream & out);
+		void printSummary(ostream & out);
+
+	private:
+
+		/**
+		 * Unit is one War Game of the tournament and what became of it.
+		 */
+		class Unit
+		{
+			public:
+				int blue;
+				int green;
+				int boardNum;
+				int seed;
+				int attempts;
+				bool done;
+				SelfPlay::GameRecord record;
+		};
+
+		/**
+		 * Worker is a worker process, the pipes to and from it,
+		 * the unit it is playing, if any, and when it got that unit.
+		 */
+		class Worker
+		{
+			public:
+				pid_t pid;
+				int toWorker;
+				int fromWorker;
+				string input;
+				int unit;
+				Stopwatch started;
+		};
+
+		int numWorkers;
+		double unitSeconds;
+		vector<Engine> engines;
+		vector<Unit> units;
+		vector<Worker> workers;
+		deque<int> pending;
+		int numRestarts;
+		double seconds;
+
+		bool startWorker(Worker & worker);
+		void stopWorker(Worker & worker);
+		bool replaceWorker(Worker & worker, int & numLeft);
+		void serve(int in, int out);
+		bool assign(Worker & worker);
+		void readResult(Worker & worker, const string & line);
+};
+
+#endif
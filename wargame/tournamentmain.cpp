@@ -0,0 +1,91 @@
+/**
+ * @file tournamentmain.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <fstream>
+#include <iostream>
+#include <signal.h>
+#include <stdlib.h>
+#include <string>
+#include "tournament.h"
+
+using namespace std;
+
+/**
+ * The main function of the tournament tool, which plays AI engines
+ * against each other on local worker processes:
+ *
+ * ./tournament [--workers=N] [--seeds=N] [--unit-timeout=S] [--records=FILE] ENGINE ENGINE...
+ *
+ * Every pair of ENGINEs (see tournament.h) plays on all five Boards,
+ * as each color, once per seed. N workers (default 4) play at once,
+ * and there are 2 seeds by default. A worker that spends more than S
+ * seconds (default 600) on one War Game is taken as hung and replaced. The results of each pair are
+ * displayed at the end, and the record of every War Game is written
+ * to FILE as CSV if it is given.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	int numWorkers = 4;
+	int numSeeds = 2;
+	double unitSeconds = 600;
+	const char * recordsFile = NULL;
+	vector<string> specs;
+	for (int i = 1; i < argc; i++)
+	{
+		string flag = argv[i];
+		if (flag.compare(0, 10, "--workers=") == 0 && atoi(flag.c_str() + 10) > 0)
+			numWorkers = atoi(flag.c_str() + 10);
+		else if (flag.compare(0, 8, "--seeds=") == 0 && atoi(flag.c_str() + 8) > 0)
+			numSeeds = atoi(flag.c_str() + 8);
+		else if (flag.compare(0, 15, "--unit-timeout=") == 0 && atof(flag.c_str() + 15) > 0)
+			unitSeconds = atof(flag.c_str() + 15);
+		else if (flag.compare(0, 10, "--records=") == 0)
+			recordsFile = argv[i] + 10;
+		else if (flag.compare(0, 2, "--") == 0)
+		{
+			cout << "Unknown flag: " << flag << endl;
+			return -1;
+		}
+		else
+			specs.push_back(flag);
+	}
+	if (specs.size() < 2)
+	{
+		cout << "Usage: ./tournament [--workers=N] [--seeds=N] [--unit-timeout=S] [--records=FILE]"
+		     << " ENGINE ENGINE..." << endl;
+		return -1;
+	}
+
+	Tournament tournament(numWorkers, unitSeconds);
+	for (unsigned int i = 0; i < specs.size(); i++)
+	{
+		if (tournament.addEngine(specs[i]) == false)
+		{
+			cout << "ENGINE ERR: " << specs[i] << " is not a valid engine" << endl;
+			return -1;
+		}
+	}
+	tournament.schedule(numSeeds);
+	//a worker that crashes must not kill the coordinator.
+	signal(SIGPIPE, SIG_IGN);
+	bool complete = tournament.run();
+	tournament.printSummary(cout);
+	if (recordsFile != NULL)
+	{
+		ofstream records(recordsFile);
+		tournament.writeRecords(records);
+	}
+	if (complete == false)
+	{
+		cout << "Some War Games failed " << Tournament::MAX_ATTEMPTS << " times and were not played" << endl;
+		return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file traindata.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "minimax.h"
+#include "multipv.h"
+
+using namespace std;
+
+/**
+ * The main function of the training data exporter, which plays War Games
+ * between AI Players and writes every position they reach to a CSV file,
+ * to train a Network (see network.h) on:
+ *
+ * ./traindata FILE [GAMES] [DEPTH] [MARGIN]
+ *
+ * GAMES War Games (default 100) are played on the five Boards in turn.
+ * Each move is picked at random among the 3 best moves of a DEPTH deep
+ * search (default 4) that are within MARGIN (default 2) of the best
+ * value, so the games vary while staying close to best play.
+ *
+ * Each row holds the Board number, the player to move, the 36 pieces row
+ * by row (B, G or N), Player Blue's score minus Player Green's, the exact
+ * value of the best move at DEPTH (9001 or -9001 if the game is won or
+ * lost), and the final score difference of the War Game.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	if (argc < 2)
+	{
+		cout << "Usage: ./traindata FILE [GAMES] [DEPTH] [MARGIN]" << endl;
+		return -1;
+	}
+	int numGames = (argc > 2 && atoi(argv[2]) > 0) ? atoi(argv[2]) : 100;
+	int depth = (argc > 3 && atoi(argv[3]) > 0) ? atoi(argv[3]) : 4;
+	int margin = (argc > 4 && atoi(argv[4]) >= 0) ? atoi(argv[4]) : 2;
+	ofstream out(argv[1]);
+	if (!out)
+	{
+		cout << "FILE ERR: " << argv[1] << " cannot be written" << endl;
+		return -1;
+	}
+	out << "board,player,cells,material,search,result" << endl;
+
+	int numPositions = 0;
+	for (int gameNum = 0; gameNum < numGames; gameNum++)
+	{
+		int boardNum = gameNum % 5 + 1;
+		srand(gameNum + 1);
+		Board * game = new Board(boardNum);
+		char currPlayer = 'B';
+		//the rows of this War Game, which wait for its result.
+		vector<string> rows;
+		while (game->isGameOver() == false)
+		{
+			MultiPV search(currPlayer, game, 3, depth);
+			string cells;
+			for (int i = 0; i < 6; i++)
+			{
+				for (int j = 0; j < 6; j++)
+				{
+					cells += game->getPlayer(i, j);
+				}
+			}
+			int blue = 0; int green = 0;
+			game->updateScore(blue, green);
+			rows.push_back(to_string(boardNum) + "," + currPlayer + "," + cells + ","
+			               + to_string(blue - green) + "," + to_string(search.getLine(0).value));
+
+			int row = 0; int col = 0;
+			search.chooseNextMove(row, col, margin);
+			game->putPiece(row, col, currPlayer);
+			currPlayer = (currPlayer == 'B') ? 'G' : 'B';
+		}
+		int blue = 0; int green = 0;
+		game->updateScore(blue, green);
+		for (unsigned int i = 0; i < rows.size(); i++)
+			out << rows[i] << "," << blue - green << endl;
+		numPositions += rows.size();
+		delete game;
+	}
+	cout << "Wrote " << numPositions << " positions from " << numGames << " War Games" << endl;
+	return 0;
+}
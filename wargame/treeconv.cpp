@@ -0,0 +1,221 @@
+/**
+ * @file treeconv.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "position.h"
+#include "treedump.h"
+
+using namespace std;
+
+/**
+ * Frame is a node whose enter record was read, but not its exit record yet.
+ */
+class Frame
+{
+	public:
+		long long id;
+		int cell;
+		int flags;
+		int alpha;
+		int beta;
+		bool shown;
+		bool hasChildren;
+};
+
+/**
+ * Formats a window bound, with the infinities of the search spelled out.
+ *
+ * @param bound Alpha or beta
+ *
+ * @return string The bound as text
+ */
+static string boundText(int bound)
+{
+	if (bound >= 1000000) return "inf";
+	if (bound <= -1000000) return "-inf";
+	return to_string(bound);
+}
+
+/**
+ * Names the reason that the search of a node ended.
+ *
+ * @param reason Reason of an exit record (see TreeDump)
+ *
+ * @return string The name of the reason
+ */
+static string reasonText(char reason)
+{
+	switch (reason)
+	{
+		case TreeDump::LEAF: return "leaf";
+		case TreeDump::TERMINAL: return "terminal";
+		case TreeDump::COMPLETE: return "complete";
+		case TreeDump::CUTOFF: return "cutoff";
+		case TreeDump::BOUND: return "bound";
+		case TreeDump::STOPPED: return "stopped";
+		case TreeDump::CACHED: return "cached";
+	}
+	return "unknown";
+}
+
+/**
+ * Formats the move that led to a node as "row,col".
+ *
+ * @param cell Cell of the move, or 255 at the root
+ *
+ * @return string The move as text
+ */
+static string moveText(int cell)
+{
+	if (cell == 255) return "root";
+	return to_string(cell / Layout::MAX_SIZE) + "," + to_string(cell % Layout::MAX_SIZE);
+}
+
+/**
+ * The main function of the tree dump converter, which turns part of a
+ * dump written by aimp2 --tree-dump into Graphviz DOT or JSON:
+ *
+ * ./treeconv FILE dot|json [--move=K] [--node=ID] [--depth=D]
+ *
+ * By default the tree of the first search in FILE is converted.
+ * --move=K converts the tree of the K-th search instead, and --node=ID
+ * the subtree of the node numbered ID, nodes being numbered from 0 in
+ * the order they were entered over the whole file. --depth=D leaves out
+ * the nodes more than D plies below the converted tree's root.
+ * The file is read as a stream, so only the nodes from the root to
+ * the current node are held in memory.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 upon sucessful execution
+ * 		   -1 upon failed execution
+ */
+int main (int argc, char ** argv)
+{
+	if (argc < 3 || (strcmp(argv[2], "dot") != 0 && strcmp(argv[2], "json") != 0))
+	{
+		cout << "Usage: ./treeconv FILE dot|json [--move=K] [--node=ID] [--depth=D]" << endl;
+		return -1;
+	}
+	bool dot = (strcmp(argv[2], "dot") == 0);
+	long long moveNum = 1;
+	long long nodeId = -1;
+	int maxDepth = 1000;
+	for (int i = 3; i < argc; i++)
+	{
+		string flag = argv[i];
+		if (flag.compare(0, 7, "--move=") == 0 && atoll(flag.c_str() + 7) > 0)
+			moveNum = atoll(flag.c_str() + 7);
+		else if (flag.compare(0, 7, "--node=") == 0 && atoll(flag.c_str() + 7) >= 0)
+			nodeId = atoll(flag.c_str() + 7);
+		else if (flag.compare(0, 8, "--depth=") == 0 && atoi(flag.c_str() + 8) >= 0)
+			maxDepth = atoi(flag.c_str() + 8);
+		else
+		{
+			cout << "Unknown flag: " << flag << endl;
+			return -1;
+		}
+	}
+	ifstream in(argv[1], ios::binary);
+	char magic[8];
+	if (!in.read(magic, 8) || memcmp(magic, "WARTREE1", 8) != 0)
+	{
+		cout << "FILE ERR: " << argv[1] << " is not a tree dump" << endl;
+		return -1;
+	}
+
+	if (dot)
+		cout << "digraph tree {" << endl << "  node [shape=box, fontname=\"monospace\"];" << endl;
+	vector<Frame> stack;
+	long long numEntered = 0;
+	long long numSearches = 0;
+	//depth in the stack of the converted tree's root, or -1 before it is found.
+	int rootDepth = -1;
+	bool finished = false;
+	char type;
+	while (finished == false && in.get(type))
+	{
+		if (type == 'E')
+		{
+			char record[TreeDump::ENTER_SIZE - 1];
+			if (!in.read(record, sizeof(record)))
+				break;
+			Frame frame;
+			frame.id = numEntered++;
+			frame.cell = (unsigned char)record[0];
+			frame.flags = record[1];
+			frame.alpha = TreeDump::getInt32(record + 3);
+			frame.beta = TreeDump::getInt32(record + 7);
+			frame.hasChildren = false;
+			if (stack.empty())
+				numSearches++;
+			if (rootDepth < 0 && ((nodeId >= 0 && frame.id == nodeId)
+			                      || (nodeId < 0 && stack.empty() && numSearches == moveNum)))
+				rootDepth = stack.size();
+			frame.shown = (rootDepth >= 0 && (int)stack.size() - rootDepth <= maxDepth);
+			if (frame.shown)
+			{
+				bool hasParent = (stack.empty() == false && stack.back().shown);
+				if (dot && hasParent)
+					cout << "  n" << stack.back().id << " -> n" << frame.id << ";" << endl;
+				else if (dot == false)
+				{
+					if (hasParent && stack.back().hasChildren)
+						cout << ",";
+					if (hasParent)
+						stack.back().hasChildren = true;
+					cout << "{\"id\":" << frame.id << ",\"move\":\"" << moveText(frame.cell)
+					     << "\",\"player\":\"" << ((frame.flags & 1) ? 'G' : 'B')
+					     << "\",\"alpha\":" << frame.alpha << ",\"beta\":" << frame.beta
+					     << ",\"reduced\":" << ((frame.flags & 2) ? "true" : "false")
+					     << ",\"children\":[";
+				}
+			}
+			stack.push_back(frame);
+		}
+		else if (type == 'X')
+		{
+			char record[TreeDump::EXIT_SIZE - 1];
+			if (!in.read(record, sizeof(record)) || stack.empty())
+				break;
+			int value = TreeDump::getInt32(record + 3);
+			Frame frame = stack.back();
+			stack.pop_back();
+			if (frame.shown && dot)
+			{
+				cout << "  n" << frame.id << " [label=\"" << moveText(frame.cell) << " "
+				     << ((frame.flags & 1) ? 'G' : 'B') << ((frame.flags & 2) ? " reduced" : "")
+				     << "\\n[" << boundText(frame.alpha) << ", " << boundText(frame.beta)
+				     << "]\\n" << value << " " << reasonText(record[0]) << "\"];" << endl;
+			}
+			else if (frame.shown)
+				cout << "],\"value\":" << value << ",\"reason\":\"" << reasonText(record[0]) << "\"}";
+			//the converted tree is done once its root is.
+			if (rootDepth >= 0 && (int)stack.size() == rootDepth)
+				finished = true;
+		}
+		else
+		{
+			cout << "FILE ERR: " << argv[1] << " is damaged" << endl;
+			return -1;
+		}
+	}
+	if (dot)
+		cout << "}" << endl;
+	else
+		cout << endl;
+	if (rootDepth < 0)
+	{
+		cerr << "The tree to convert is not in " << argv[1] << endl;
+		return -1;
+	}
+	return 0;
+}
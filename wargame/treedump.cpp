@@ -0,0 +1,180 @@
+/**
+ * @file treedump.cpp
+ * @author Rahul Kumar and Roger Xiao
+ */
+#include "treedump.h"
+#include <string.h>
+
+using namespace std;
+
+/**
+ * Constructor that creates the dump file.
+ *
+ * @param filename Name of the dump file
+ * @param maxDepth Deepest nodes to write, the root being depth 0
+ * @param sampleEvery Keep one in sampleEvery of the subtrees at SAMPLE_DEPTH
+ *        (1 keeps them all)
+ */
+TreeDump::TreeDump(const char * filename, int maxDepth, int sampleEvery)
+	: out(filename, ios::binary)
+{
+	this->numUsed = 0;
+	this->maxDepth = maxDepth;
+	this->sampleEvery = (sampleEvery > 0) ? sampleEvery : 1;
+	this->level = 0;
+	this->skipDepth = -1;
+	this->numSampled = 0;
+	this->numNodes = 0;
+	this->write("WARTREE1", 8);
+}
+
+/**
+ * Writes out what is left in the buffer.
+ */
+TreeDump::~TreeDump()
+{
+	this->flush();
+}
+
+/**
+ * Getter function
+ *
+ * @return True if the dump file could be created
+ */
+bool TreeDump::isOpen()
+{
+	return out.is_open() && out.good();
+}
+
+/**
+ * Records that the search starts on a node.
+ *
+ * @param cell Cell of the move that led to the node, or -1 at the root
+ * @param player Player to move at the node
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ * @param reduced True if the node is searched one ply shallower
+ */
+void TreeDump::enter(int cell, char player, int alpha, int beta, bool reduced)
+{
+	int depth = level++;
+	if (skipDepth >= 0)
+		return;
+	//leave out the nodes that are too deep or not sampled, with their subtrees.
+	if (depth > maxDepth || (depth == SAMPLE_DEPTH && (numSampled++ % sampleEvery) != 0))
+	{
+		skipDepth = depth;
+		return;
+	}
+	char record[ENTER_SIZE];
+	record[0] = 'E';
+	record[1] = (cell < 0) ? (char)255 : (char)cell;
+	record[2] = (player == 'G' ? 1 : 0) | (reduced ? 2 : 0);
+	record[3] = 0;
+	putInt32(record + 4, alpha);
+	putInt32(record + 8, beta);
+	this->write(record, ENTER_SIZE);
+	numNodes++;
+}
+
+/**
+ * Records that the search is done with the node entered last.
+ *
+ * @param value Value of the node
+ * @param reason Why the search of the node ended
+ */
+void TreeDump::exit(int value, char reason)
+{
+	int depth = --level;
+	if (skipDepth >= 0)
+	{
+		if (depth == skipDepth)
+			skipDepth = -1;
+		return;
+	}
+	char record[EXIT_SIZE];
+	record[0] = 'X';
+	record[1] = reason;
+	record[2] = 0;
+	record[3] = 0;
+	putInt32(record + 4, value);
+	this->write(record, EXIT_SIZE);
+}
+
+/**
+ * Records a node that was evaluated without being searched.
+ *
+ * @param cell Cell of the move that led to the node
+ * @param player Player to move at the node
+ * @param alpha Best alternative available to the Max player
+ * @param beta Best alternative available to the Min player
+ * @param value Value of the node
+ * @param reason LEAF or TERMINAL
+ */
+void TreeDump::leaf(int cell, char player, int alpha, int beta, int value, char reason)
+{
+	this->enter(cell, player, alpha, beta, false);
+	this->exit(value, reason);
+}
+
+/**
+ * Getter function
+ *
+ * @return numNodes Number of nodes written so far
+ */
+long long TreeDump::getNumNodes()
+{
+	return this->numNodes;
+}
+
+/**
+ * Writes a number as 4 bytes, little-endian, whatever the machine's byte order.
+ *
+ * @param bytes Where to write the 4 bytes
+ * @param value The number, which must fit in an int32
+ */
+void TreeDump::putInt32(char * bytes, int value)
+{
+	uint32_t bits = (uint32_t)value;
+	for (int i = 0; i < 4; i++)
+		bytes[i] = (char)((bits >> (8 * i)) & 0xFF);
+}
+
+/**
+ * Reads a number written by putInt32.
+ *
+ * @param bytes The 4 bytes
+ *
+ * @return int The number
+ */
+int TreeDump::getInt32(const char * bytes)
+{
+	uint32_t bits = 0;
+	for (int i = 0; i < 4; i++)
+		bits |= (uint32_t)(unsigned char)bytes[i] << (8 * i);
+	return (int32_t)bits;
+}
+
+/**
+ * Adds bytes to the buffer, writing the buffer out when it is full.
+ *
+ * @param data Bytes to add
+ * @param size Number of bytes
+ */
+void TreeDump::write(const void * data, int size)
+{
+	if (numUsed + size > BUFFER_SIZE)
+		this->flush();
+	memcpy(buffer + numUsed, data, size);
+	numUsed += size;
+}
+
+/**
+ * Writes the buffer out to the dump file.
+ */
+void TreeDump::flush()
+{
+	out.write(buffer, numUsed);
+	out.flush();
+	numUsed = 0;
+}
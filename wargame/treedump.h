@@ -0,0 +1,82 @@
+/**
+ * @file treedump.h
+ * @author Rahul Kumar and Roger Xiao
+ */
+#ifndef TREEDUMP_H
+#define TREEDUMP_H
+
+#include <fstream>
+#include <stdint.h>
+
+using namespace std;
+
+/**
+ * This class streams the nodes a search visits to a binary file while
+ * the search runs, so a search tree can be looked at after it is gone.
+ * Only a fixed-size buffer is kept in memory, however big the tree is.
+ *
+ * The file starts with the 8 bytes "WARTREE1", followed by two kinds of
+ * records. An enter record is written when the search starts on a node,
+ * and an exit record when it is done with it, so the records of a node's
+ * children sit between its enter and exit records:
+ *
+ * enter (12 bytes): 'E', cell (255 at the root), flags, 0, alpha (int32), beta (int32)
+ * exit (8 bytes):   'X', reason, 0, 0, value (int32)
+ *
+ * The cell of a move at row r and col c is r * 6 + c, whatever the size
+ * of the board. Bit 0 of flags is set if Player Green is to move at the
+ * node, and bit 1 if it is searched one ply shallower by late move
+ * reductions. The reasons are listed below. Each search is one tree in
+ * the file, and the numbers are written byte by byte, little-endian.
+ *
+ * To keep tracing cheap, nodes deeper than a maximum depth can be left
+ * out, and only one in so many of the subtrees below depth 1 can be kept.
+ */
+class TreeDump
+{
+	public:
+		//why the search of a node ended.
+		static const char LEAF = 'l';
+		static const char TERMINAL = 't';
+		static const char COMPLETE = 'c';
+		static const char CUTOFF = 'a';
+		static const char BOUND = 'b';
+		static const char STOPPED = 's';
+		static const char CACHED = 'h';
+
+		static const int ENTER_SIZE = 12;
+		static const int EXIT_SIZE = 8;
+		static const int SAMPLE_DEPTH = 2;
+
+		TreeDump(const char * filename, int maxDepth, int sampleEvery);
+		~TreeDump();
+		bool isOpen();
+
+		void enter(int cell, char player, int alpha, int beta, bool reduced);
+		void exit(int value, char reason);
+		void leaf(int cell, char player, int alpha, int beta, int value, char reason);
+		long long getNumNodes();
+
+		static void putInt32(char * bytes, int value);
+		static int getInt32(const char * bytes);
+
+	private:
+		static const int BUFFER_SIZE = 1 << 16;
+
+		ofstream out;
+		char buffer[BUFFER_SIZE];
+		int numUsed;
+		int maxDepth;
+		int sampleEvery;
+		//depth of the next node entered, the root being depth 0.
+		int level;
+		//depth of the subtree being left out, or -1.
+		int skipDepth;
+		unsigned long long numSampled;
+		long long numNodes;
+
+		void write(const void * data, int size);
+		void flush();
+};
+
+#endif